@@ -0,0 +1,400 @@
+// Standalone benchmarks for the matching pipeline on synthetic data.
+// Each result is printed as one "bench=<name> key=value ..." line so runs
+// from different commits can be diffed or joined on the bench name.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include "../utils.h"
+#include "../metrics.h"
+#include "../match_allocator.h"
+#include "../shard.h"
+#include "../skills.h"
+#include "../fairness.h"
+#include "datagen.h"
+
+typedef struct {
+    DatagenConfig data;
+    double min_seconds;   // keep repeating a stage for at least this long
+    int min_repeats;
+    const char* label;    // free-form tag (e.g. a commit id) echoed on every line
+    const char* csv_dir;  // where generated CSV files are written
+    double measured_density;
+    int workers;          // shard worker processes, 0 to skip the sharded stage
+    int shard_nodes;      // largest shard side
+    int fairness;         // fairness weight for the fairness stage, 0 to skip it
+} BenchConfig;
+
+typedef struct {
+    const BenchConfig* config;
+    Freelancer* freelancers;
+    Project* projects;
+    Assignment* assignments;
+    SolverWorkspace solver;   // holds the graph for the solve-only stage
+    Freelancer* read_freelancers_buf;
+    Project* read_projects_buf;
+    char freelancers_csv[512];
+    char projects_csv[512];
+    char availability_csv[512];
+    MatchQuality greedy_quality;
+    int* shard_assignment;
+    ShardStats shard_stats;
+    long checksum;        // consumed results so the compiler cannot drop the work
+} BenchContext;
+
+typedef void (*BenchFunction)(BenchContext* context);
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static long peak_rss_kb(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Repeat a stage until both the time and repeat minimums are met and
+// return the mean seconds per call
+static double time_stage(BenchContext* context, BenchFunction function, int* repeats) {
+    int count = 0;
+    double start = now_seconds();
+    double elapsed = 0;
+    do {
+        function(context);
+        count++;
+        elapsed = now_seconds() - start;
+    } while (elapsed < context->config->min_seconds || count < context->config->min_repeats);
+    *repeats = count;
+    return elapsed / count;
+}
+
+static void report(const BenchContext* context, const char* name, double seconds_per_call,
+                   int repeats, double ops_per_call, double pairs_per_call) {
+    const DatagenConfig* data = &context->config->data;
+    printf("bench=%s label=%s F=%d P=%d V=%d zipf=%.2f density=%.4f repeats=%d "
+           "ns_per_op=%.1f pairs_per_s=%.0f peak_rss_kb=%ld\n",
+           name, context->config->label, data->num_freelancers, data->num_projects,
+           data->vocab_size, data->zipf_exponent, context->config->measured_density, repeats,
+           seconds_per_call * 1e9 / ops_per_call,
+           pairs_per_call > 0 ? pairs_per_call / seconds_per_call : 0,
+           peak_rss_kb());
+    fflush(stdout);
+}
+
+// The CSV readers log to stdout; keep that out of the result lines
+static int silence_stdout(void) {
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    dup2(devnull, STDOUT_FILENO);
+    close(devnull);
+    return saved;
+}
+
+static void restore_stdout(int saved) {
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+}
+
+static void bench_read_freelancers(BenchContext* context) {
+    int count = 0;
+    read_freelancers_limit(context->freelancers_csv, context->read_freelancers_buf,
+                           context->config->data.num_freelancers, &count);
+    context->checksum += count;
+}
+
+static void bench_read_projects(BenchContext* context) {
+    int count = 0;
+    read_projects_limit(context->projects_csv, context->read_projects_buf,
+                        context->config->data.num_projects, &count);
+    context->checksum += count;
+}
+
+static void bench_read_availability(BenchContext* context) {
+    read_availability(context->availability_csv, context->read_freelancers_buf,
+                      context->config->data.num_freelancers);
+    context->checksum += context->read_freelancers_buf[0].availability;
+}
+
+static void bench_compatibility(BenchContext* context) {
+    const DatagenConfig* data = &context->config->data;
+    long sum = 0;
+    for (int i = 0; i < data->num_freelancers; i++) {
+        for (int j = 0; j < data->num_projects; j++) {
+            sum += calculate_compatibility(&context->freelancers[i], &context->projects[j]);
+        }
+    }
+    context->checksum += sum;
+}
+
+static void bench_build_graph(BenchContext* context) {
+    const DatagenConfig* data = &context->config->data;
+    build_compatibility_graph(&context->solver, context->freelancers, data->num_freelancers,
+                              context->projects, data->num_projects);
+    context->checksum += context->solver.graph.num_edges;
+}
+
+static void bench_match(BenchContext* context) {
+    const DatagenConfig* data = &context->config->data;
+    context->checksum += match_freelancers_to_projects(context->freelancers, data->num_freelancers,
+                                                       context->projects, data->num_projects,
+                                                       context->assignments);
+}
+
+static void bench_hungarian(BenchContext* context) {
+    hungarian_solve(&context->solver, &context->solver.graph, context->solver.row_assignment);
+    context->checksum += context->solver.row_assignment[0];
+}
+
+static void bench_greedy(BenchContext* context) {
+    greedy_solve(&context->solver, &context->solver.graph, context->solver.row_assignment,
+                 &context->greedy_quality);
+    context->checksum += context->greedy_quality.objective;
+}
+
+static void bench_sharded(BenchContext* context) {
+    sharded_solve(&context->solver.graph, NULL, context->shard_assignment, &context->shard_stats);
+    context->checksum += context->shard_assignment[0];
+}
+
+// Total score of a per-row assignment on the solver's graph
+static long assignment_objective(const BipartiteGraph* graph, const int* assignment) {
+    long total = 0;
+    for (int i = 0; i < graph->num_freelancers; i++) {
+        for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+            if (graph->edge_project[e] == assignment[i]) total += graph->edge_weight[e];
+        }
+    }
+    return total;
+}
+
+static void bench_format_json(BenchContext* context) {
+    const DatagenConfig* data = &context->config->data;
+    char* json = format_matches_json(context->freelancers, data->num_freelancers,
+                                     context->projects, data->num_projects,
+                                     context->assignments);
+    context->checksum += strlen(json);
+    free(json);
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  -f N     freelancers (default 1000)\n"
+            "  -p N     projects (default 1000)\n"
+            "  -v N     skill vocabulary size (default 500)\n"
+            "  -z S     Zipf exponent for skill frequency (default 1.0)\n"
+            "  -d D     target edge density, 0-1 (default 0.05)\n"
+            "  -k N     skills per freelancer (default 6)\n"
+            "  -K N     required skills per project (default 3)\n"
+            "  -s N     random seed (default 12345)\n"
+            "  -t SEC   minimum seconds per stage (default 0.2)\n"
+            "  -r N     minimum repeats per stage (default 1)\n"
+            "  -l TEXT  label printed on every result line\n"
+            "  -o DIR   directory for generated CSV files (default /tmp)\n"
+            "  -M       disable stage metrics (to measure their overhead)\n"
+            "  -w N     also solve across N shard worker processes\n"
+            "  -n N     largest shard side for -w (default %d)\n"
+            "  -S FILE  load a skill similarity file before generating data\n"
+            "  -E PCT   experience floor, as a percentage of min_experience (default 0)\n"
+            "  -F PCT   fairness weight for the re-solve after one recorded solve (default 100, 0 skips)\n",
+            program, SHARD_DEFAULT_MAX_NODES);
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    datagen_default_config(&config.data);
+    config.min_seconds = 0.2;
+    config.min_repeats = 1;
+    config.label = "-";
+    config.csv_dir = "/tmp";
+    config.workers = 0;
+    config.shard_nodes = SHARD_DEFAULT_MAX_NODES;
+    config.fairness = 100;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "f:p:v:z:d:k:K:s:t:r:l:o:Mw:n:S:E:F:h")) != -1) {
+        switch (opt) {
+            case 'f': config.data.num_freelancers = atoi(optarg); break;
+            case 'p': config.data.num_projects = atoi(optarg); break;
+            case 'v': config.data.vocab_size = atoi(optarg); break;
+            case 'z': config.data.zipf_exponent = atof(optarg); break;
+            case 'd': config.data.edge_density = atof(optarg); break;
+            case 'k': config.data.skills_per_freelancer = atoi(optarg); break;
+            case 'K': config.data.skills_per_project = atoi(optarg); break;
+            case 's': config.data.seed = (unsigned int)strtoul(optarg, NULL, 10); break;
+            case 't': config.min_seconds = atof(optarg); break;
+            case 'r': config.min_repeats = atoi(optarg); break;
+            case 'l': config.label = optarg; break;
+            case 'o': config.csv_dir = optarg; break;
+            case 'M': metrics_set_enabled(0); break;
+            case 'w': config.workers = atoi(optarg); break;
+            case 'n': config.shard_nodes = atoi(optarg); break;
+            case 'E': set_min_experience_percent(atoi(optarg)); break;
+            case 'F': config.fairness = atoi(optarg); break;
+            case 'S':
+                if (skills_load_similarity(optarg) < 0) return 1;
+                break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (config.data.num_freelancers <= 0 || config.data.num_projects <= 0 ||
+        config.data.vocab_size <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    int num_freelancers = config.data.num_freelancers;
+    int num_projects = config.data.num_projects;
+
+    BenchContext context = {0};
+    context.config = &config;
+    context.freelancers = (Freelancer*)calloc(num_freelancers, sizeof(Freelancer));
+    context.projects = (Project*)calloc(num_projects, sizeof(Project));
+    context.assignments = (Assignment*)calloc(num_freelancers, sizeof(Assignment));
+    context.read_freelancers_buf = (Freelancer*)calloc(num_freelancers, sizeof(Freelancer));
+    context.read_projects_buf = (Project*)calloc(num_projects, sizeof(Project));
+    if (!context.freelancers || !context.projects || !context.assignments ||
+        !context.read_freelancers_buf || !context.read_projects_buf) {
+        fprintf(stderr, "Out of memory for %d freelancers x %d projects\n",
+                num_freelancers, num_projects);
+        return 1;
+    }
+
+    datagen_generate(&config.data, context.freelancers, context.projects);
+    config.measured_density = datagen_measure_density(context.freelancers, num_freelancers,
+                                                      context.projects, num_projects);
+    printf("# dataset F=%d P=%d V=%d zipf=%.2f target_density=%.4f measured_density=%.4f seed=%u\n",
+           num_freelancers, num_projects, config.data.vocab_size, config.data.zipf_exponent,
+           config.data.edge_density, config.measured_density, config.data.seed);
+
+    if (datagen_write_csv(config.csv_dir, context.freelancers, num_freelancers,
+                          context.projects, num_projects) != 0) {
+        fprintf(stderr, "Could not write CSV files to %s\n", config.csv_dir);
+        return 1;
+    }
+    snprintf(context.freelancers_csv, sizeof(context.freelancers_csv), "%s/freelancers.csv", config.csv_dir);
+    snprintf(context.projects_csv, sizeof(context.projects_csv), "%s/projects.csv", config.csv_dir);
+    snprintf(context.availability_csv, sizeof(context.availability_csv), "%s/availability.csv", config.csv_dir);
+
+    double pairs = (double)num_freelancers * num_projects;
+    double seconds;
+    int repeats;
+
+    int saved_stdout = silence_stdout();
+    seconds = time_stage(&context, bench_read_freelancers, &repeats);
+    restore_stdout(saved_stdout);
+    report(&context, "read_freelancers", seconds, repeats, num_freelancers, 0);
+
+    saved_stdout = silence_stdout();
+    seconds = time_stage(&context, bench_read_projects, &repeats);
+    restore_stdout(saved_stdout);
+    report(&context, "read_projects", seconds, repeats, num_projects, 0);
+
+    saved_stdout = silence_stdout();
+    seconds = time_stage(&context, bench_read_availability, &repeats);
+    restore_stdout(saved_stdout);
+    report(&context, "read_availability", seconds, repeats, num_freelancers, 0);
+
+    seconds = time_stage(&context, bench_compatibility, &repeats);
+    report(&context, "calculate_compatibility", seconds, repeats, pairs, pairs);
+
+    seconds = time_stage(&context, bench_match, &repeats);
+    report(&context, "match_freelancers_to_projects", seconds, repeats, 1, pairs);
+
+    // Solve only, on a graph built once up front
+    MatchQuality exact_quality;
+    solver_workspace_init(&context.solver);
+    match_with_mode(&context.solver, SOLVER_EXACT, context.freelancers, num_freelancers,
+                    context.projects, num_projects, context.assignments, &exact_quality);
+    // Graph construction through the skill index (pairs_per_s counts all F x P
+    // pairs, so it compares directly with calculate_compatibility above)
+    seconds = time_stage(&context, bench_build_graph, &repeats);
+    report(&context, "build_graph", seconds, repeats, 1, pairs);
+    printf("# build_graph edges=%d of %.0f pairs\n", context.solver.graph.num_edges, pairs);
+
+    seconds = time_stage(&context, bench_hungarian, &repeats);
+    report(&context, "hungarian_algorithm", seconds, repeats, 1, pairs);
+
+    // Record that solve as history and solve again with the fairness penalty
+    // in the costs: how many busy freelancers it moves. Fairness only breaks
+    // ties, so giving up any total score is a failure.
+    int status = 0;
+    if (config.fairness > 0) {
+        int* previous = (int*)malloc((num_freelancers + 1) * sizeof(int));
+        uint8_t* penalty = (uint8_t*)malloc(num_freelancers + 1);
+        memcpy(previous, context.solver.row_assignment, num_freelancers * sizeof(int));
+        fairness_record(context.freelancers, num_freelancers, previous);
+        fairness_set_weight(config.fairness);
+        fairness_penalties(context.freelancers, num_freelancers, penalty);
+        context.solver.row_penalty = penalty;
+        seconds = time_stage(&context, bench_hungarian, &repeats);
+        report(&context, "hungarian_fairness", seconds, repeats, 1, pairs);
+        long fair_objective = assignment_objective(&context.solver.graph, context.solver.row_assignment);
+        int reassigned = 0;
+        for (int i = 0; i < num_freelancers; i++) {
+            if (previous[i] >= 0 && context.solver.row_assignment[i] != previous[i]) reassigned++;
+        }
+        printf("# fairness weight=%d objective=%ld exact=%ld score_cost=%ld reassigned=%d\n",
+               config.fairness, fair_objective, exact_quality.objective,
+               exact_quality.objective - fair_objective, reassigned);
+        if (fair_objective != exact_quality.objective) {
+            fprintf(stderr, "fairness solve lost score: objective %ld, exact %ld\n",
+                    fair_objective, exact_quality.objective);
+            status = 1;
+        }
+        context.solver.row_penalty = NULL;
+        fairness_set_weight(0);
+        free(previous);
+        free(penalty);
+    }
+
+    // Greedy fast path on the same graph, with how far it lands from the optimum
+    seconds = time_stage(&context, bench_greedy, &repeats);
+    report(&context, "greedy_solve", seconds, repeats, 1, pairs);
+    printf("# greedy objective=%ld exact=%ld upper_bound=%ld gap_to_exact=%.2f%%\n",
+           context.greedy_quality.objective, exact_quality.objective,
+           context.greedy_quality.upper_bound,
+           exact_quality.objective > 0 ?
+               (double)(exact_quality.objective - context.greedy_quality.objective) /
+               exact_quality.objective * 100 : 0.0);
+
+    // Same graph across worker processes, started only now so the stages
+    // above stay single-process
+    if (config.workers > 0 && shard_pool_start(config.workers, config.shard_nodes) > 0) {
+        context.shard_assignment = (int*)malloc((num_freelancers + 1) * sizeof(int));
+        seconds = time_stage(&context, bench_sharded, &repeats);
+        report(&context, "sharded_solve", seconds, repeats, 1, pairs);
+        long sharded_objective = assignment_objective(&context.solver.graph, context.shard_assignment);
+        printf("# sharded workers=%d shards=%d components=%d split_components=%d cross_edges=%d "
+               "reconciled=%d objective=%ld exact=%ld gap_to_exact=%.2f%%\n",
+               shard_pool_size(), context.shard_stats.shards, context.shard_stats.components,
+               context.shard_stats.split_components, context.shard_stats.cross_edges,
+               context.shard_stats.reconciled, sharded_objective, exact_quality.objective,
+               exact_quality.objective > 0 ?
+                   (double)(exact_quality.objective - sharded_objective) /
+                   exact_quality.objective * 100 : 0.0);
+        shard_pool_stop();
+        free(context.shard_assignment);
+    }
+
+    seconds = time_stage(&context, bench_format_json, &repeats);
+    report(&context, "format_matches_json", seconds, repeats, 1, 0);
+
+    fprintf(stderr, "checksum %ld\n", context.checksum);
+
+    solver_workspace_free(&context.solver);
+    free(context.freelancers);
+    free(context.projects);
+    free(context.assignments);
+    free(context.read_freelancers_buf);
+    free(context.read_projects_buf);
+    return status;
+}
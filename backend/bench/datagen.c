@@ -0,0 +1,192 @@
+#include "datagen.h"
+#include "../skills.h"
+#include <math.h>
+
+// xorshift32 keeps generated datasets identical across platforms
+static unsigned int next_random(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static double next_unit(unsigned int* state) {
+    return (next_random(state) >> 8) * (1.0 / 16777216.0);
+}
+
+// Sample a skill index from the Zipf CDF by binary search
+static int sample_skill(const double* cdf, int vocab_size, unsigned int* state) {
+    double u = next_unit(state);
+    int lo = 0, hi = vocab_size - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (cdf[mid] < u) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static int contains_skill(const int* chosen, int count, int skill) {
+    for (int i = 0; i < count; i++) {
+        if (chosen[i] == skill) return 1;
+    }
+    return 0;
+}
+
+void datagen_default_config(DatagenConfig* config) {
+    config->num_freelancers = 1000;
+    config->num_projects = 1000;
+    config->vocab_size = 500;
+    config->zipf_exponent = 1.0;
+    config->edge_density = 0.05;
+    config->skills_per_freelancer = 6;
+    config->skills_per_project = 3;
+    config->seed = 12345;
+}
+
+void datagen_generate(const DatagenConfig* config, Freelancer* freelancers, Project* projects) {
+    unsigned int state = config->seed ? config->seed : 1;
+    int vocab_size = config->vocab_size;
+    int per_freelancer = config->skills_per_freelancer;
+    int per_project = config->skills_per_project;
+    if (per_freelancer > MAX_SKILLS) per_freelancer = MAX_SKILLS;
+    if (per_project > MAX_SKILLS) per_project = MAX_SKILLS;
+    if (per_freelancer > vocab_size) per_freelancer = vocab_size;
+    if (per_project > vocab_size) per_project = vocab_size;
+
+    // Zipf CDF over skill ranks
+    double* cdf = (double*)malloc(vocab_size * sizeof(double));
+    double total = 0;
+    for (int s = 0; s < vocab_size; s++) {
+        total += 1.0 / pow(s + 1, config->zipf_exponent);
+        cdf[s] = total;
+    }
+    for (int s = 0; s < vocab_size; s++) {
+        cdf[s] /= total;
+    }
+
+    // Freelancers draw skills from the skewed distribution
+    int* document_frequency = (int*)calloc(vocab_size, sizeof(int));
+    for (int i = 0; i < config->num_freelancers; i++) {
+        Freelancer* f = &freelancers[i];
+        int chosen[MAX_SKILLS];
+        int count = 0;
+        for (int attempt = 0; count < per_freelancer && attempt < per_freelancer * 16; attempt++) {
+            int skill = sample_skill(cdf, vocab_size, &state);
+            if (!contains_skill(chosen, count, skill)) chosen[count++] = skill;
+        }
+
+        f->id = i + 1;
+        snprintf(f->name, MAX_NAME_LENGTH, "Freelancer %d", i + 1);
+        f->num_skills = count;
+        for (int k = 0; k < count; k++) {
+            snprintf(f->skills[k], MAX_SKILL_LENGTH, "skill%d", chosen[k]);
+            document_frequency[chosen[k]]++;
+        }
+        skills_intern_list(f->skills, f->num_skills, f->skill_ids);
+        f->experience = next_random(&state) % 16;
+        f->availability = (AvailabilityMask)(next_random(&state) & FULL_WEEK_MASK);
+    }
+
+    // Each project is compatible with the union of its skills' freelancers, so
+    // pick skills whose summed frequency stays near the target edge count
+    double target = config->edge_density * config->num_freelancers;
+    for (int j = 0; j < config->num_projects; j++) {
+        Project* p = &projects[j];
+        int chosen[MAX_SKILLS];
+        int count = 0;
+        double covered = 0;
+
+        // Anchor skill: the sampled candidate closest to the target frequency
+        int anchor = sample_skill(cdf, vocab_size, &state);
+        for (int attempt = 0; attempt < 32; attempt++) {
+            int skill = sample_skill(cdf, vocab_size, &state);
+            if (fabs(document_frequency[skill] - target) < fabs(document_frequency[anchor] - target)) {
+                anchor = skill;
+            }
+        }
+        chosen[count++] = anchor;
+        covered = document_frequency[anchor];
+
+        for (int attempt = 0; count < per_project && attempt < per_project * 16; attempt++) {
+            int skill = sample_skill(cdf, vocab_size, &state);
+            if (contains_skill(chosen, count, skill)) continue;
+            if (covered + document_frequency[skill] > target) continue;
+            chosen[count++] = skill;
+            covered += document_frequency[skill];
+        }
+
+        p->id = 100001 + j;
+        snprintf(p->name, MAX_NAME_LENGTH, "Project %d", j + 1);
+        p->num_required_skills = count;
+        for (int k = 0; k < count; k++) {
+            snprintf(p->required_skills[k], MAX_SKILL_LENGTH, "skill%d", chosen[k]);
+        }
+        skills_intern_list(p->required_skills, p->num_required_skills, p->required_skill_ids);
+        p->min_experience = 1 + next_random(&state) % 10;
+        p->deadline_days = 1 + next_random(&state) % 30;
+    }
+
+    free(document_frequency);
+    free(cdf);
+}
+
+double datagen_measure_density(const Freelancer* freelancers, int num_freelancers,
+                               const Project* projects, int num_projects) {
+    if (num_freelancers == 0 || num_projects == 0) return 0;
+    long edges = 0;
+    for (int i = 0; i < num_freelancers; i++) {
+        for (int j = 0; j < num_projects; j++) {
+            if (calculate_compatibility(&freelancers[i], &projects[j]) > 0) edges++;
+        }
+    }
+    return (double)edges / ((double)num_freelancers * num_projects);
+}
+
+int datagen_write_csv(const char* dir, const Freelancer* freelancers, int num_freelancers,
+                      const Project* projects, int num_projects) {
+    char path[512];
+
+    snprintf(path, sizeof(path), "%s/freelancers.csv", dir);
+    FILE* file = fopen(path, "w");
+    if (!file) return -1;
+    fprintf(file, "id,name,skills,experience\n");
+    for (int i = 0; i < num_freelancers; i++) {
+        fprintf(file, "%d,%s,", freelancers[i].id, freelancers[i].name);
+        for (int k = 0; k < freelancers[i].num_skills; k++) {
+            fprintf(file, "%s%s", k > 0 ? " " : "", freelancers[i].skills[k]);
+        }
+        fprintf(file, ",%d\n", freelancers[i].experience);
+    }
+    fclose(file);
+
+    snprintf(path, sizeof(path), "%s/projects.csv", dir);
+    file = fopen(path, "w");
+    if (!file) return -1;
+    fprintf(file, "id,name,skills,experience,deadline_days\n");
+    for (int j = 0; j < num_projects; j++) {
+        fprintf(file, "%d,%s,", projects[j].id, projects[j].name);
+        for (int k = 0; k < projects[j].num_required_skills; k++) {
+            fprintf(file, "%s%s", k > 0 ? " " : "", projects[j].required_skills[k]);
+        }
+        fprintf(file, ",%d,%d\n", projects[j].min_experience, projects[j].deadline_days);
+    }
+    fclose(file);
+
+    // availability.csv encodes the day as (project_id - 101) % 7
+    snprintf(path, sizeof(path), "%s/availability.csv", dir);
+    file = fopen(path, "w");
+    if (!file) return -1;
+    fprintf(file, "freelancer_id,project_id,available\n");
+    for (int i = 0; i < num_freelancers; i++) {
+        for (int d = 0; d < DAYS_PER_WEEK; d++) {
+            if ((freelancers[i].availability >> d) & 1u) {
+                fprintf(file, "%d,%d,1\n", freelancers[i].id, 101 + d);
+            }
+        }
+    }
+    fclose(file);
+    return 0;
+}
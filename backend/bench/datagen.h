@@ -0,0 +1,31 @@
+#ifndef DATAGEN_H
+#define DATAGEN_H
+
+#include "../utils.h"
+
+// Parameters for a synthetic dataset
+typedef struct {
+    int num_freelancers;
+    int num_projects;
+    int vocab_size;             // number of distinct skills
+    double zipf_exponent;       // skill-frequency skew (0 = uniform)
+    double edge_density;        // target fraction of compatible freelancer/project pairs
+    int skills_per_freelancer;
+    int skills_per_project;
+    unsigned int seed;
+} DatagenConfig;
+
+void datagen_default_config(DatagenConfig* config);
+
+// Fill freelancers/projects (caller-allocated, sized from config)
+void datagen_generate(const DatagenConfig* config, Freelancer* freelancers, Project* projects);
+
+// Fraction of pairs with a non-zero compatibility score
+double datagen_measure_density(const Freelancer* freelancers, int num_freelancers,
+                               const Project* projects, int num_projects);
+
+// Write freelancers.csv, projects.csv and availability.csv into dir
+int datagen_write_csv(const char* dir, const Freelancer* freelancers, int num_freelancers,
+                      const Project* projects, int num_projects);
+
+#endif // DATAGEN_H
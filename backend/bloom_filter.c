@@ -61,3 +61,13 @@ bool bloom_check(const BloomFilter* filter, const char* item) {
 void bloom_free(BloomFilter* filter) {
     // No dynamic memory to free
 }
+
+// Fraction of bits set; false-positive rate grows roughly as fill^hash_count
+double bloom_fill_ratio(const BloomFilter* filter) {
+    if (filter->size == 0) return 0;
+    size_t set_bits = 0;
+    for (size_t i = 0; i < filter->size / 8; i++) {
+        set_bits += __builtin_popcount(filter->bits[i]);
+    }
+    return (double)set_bits / filter->size;
+}
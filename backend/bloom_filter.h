@@ -18,5 +18,6 @@ void bloom_init(BloomFilter* filter);
 void bloom_add(BloomFilter* filter, const char* item);
 bool bloom_check(const BloomFilter* filter, const char* item);
 void bloom_free(BloomFilter* filter);
+double bloom_fill_ratio(const BloomFilter* filter);
 
 #endif // BLOOM_FILTER_H
@@ -1,4 +1,5 @@
 #include "bloom_filter_utils.h"
+#include "skills.h"
 #include <string.h>
 
 void populate_bloom_with_freelancer_skills(GlobalBloom* global_bloom, const Freelancer* freelancers, int num_freelancers) {
@@ -6,7 +7,9 @@ void populate_bloom_with_freelancer_skills(GlobalBloom* global_bloom, const Free
     bloom_init(&global_bloom->filter);
     for (int i = 0; i < num_freelancers; i++) {
         for (int j = 0; j < freelancers[i].num_skills; j++) {
-            bloom_add(&global_bloom->filter, freelancers[i].skills[j]);
+            char canonical[MAX_SKILL_LENGTH];
+            skill_canonical(freelancers[i].skills[j], canonical, sizeof(canonical));
+            bloom_add(&global_bloom->filter, canonical);
         }
     }
     global_bloom->initialized = 1;
@@ -0,0 +1,140 @@
+#include <limits.h>
+#include "candidates.h"
+#include "skills.h"
+
+void candidate_index_init(CandidateIndex* index) {
+    memset(index, 0, sizeof(*index));
+}
+
+void candidate_index_free(CandidateIndex* index) {
+    free(index->posting_start);
+    free(index->posting);
+    free(index->posting_experience);
+    free(index->seen);
+    free(index->candidates);
+    candidate_index_init(index);
+}
+
+// Grow an int array that holds `capacity` entries to at least `needed`
+static int reserve(int** array, int needed, int capacity) {
+    if (needed <= capacity) return 1;
+    int* grown = (int*)realloc(*array, (size_t)needed * sizeof(int));
+    if (!grown) return 0;
+    *array = grown;
+    return 1;
+}
+
+typedef struct {
+    int min_experience;
+    int project;
+} ProjectKey;
+
+static int compare_project_keys(const void* a, const void* b) {
+    const ProjectKey* x = (const ProjectKey*)a;
+    const ProjectKey* y = (const ProjectKey*)b;
+    if (x->min_experience != y->min_experience) return x->min_experience < y->min_experience ? -1 : 1;
+    return x->project - y->project;
+}
+
+static int compare_ints(const void* a, const void* b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+int candidate_index_build(CandidateIndex* index, const Project* projects, int num_projects) {
+    int num_skills = skills_count();
+    int total = 0;
+    for (int j = 0; j < num_projects; j++) total += projects[j].num_required_skills;
+
+    int skill_slots = num_skills + 2;
+    if (!reserve(&index->posting_start, skill_slots, index->skill_capacity)) return 0;
+    if (skill_slots > index->skill_capacity) index->skill_capacity = skill_slots;
+    if (!reserve(&index->posting, total + 1, index->posting_capacity) ||
+        !reserve(&index->posting_experience, total + 1, index->posting_capacity)) {
+        return 0;
+    }
+    if (total + 1 > index->posting_capacity) index->posting_capacity = total + 1;
+    if (!reserve(&index->seen, num_projects + 1, index->project_capacity) ||
+        !reserve(&index->candidates, num_projects + 1, index->project_capacity)) {
+        return 0;
+    }
+    if (num_projects + 1 > index->project_capacity) index->project_capacity = num_projects + 1;
+    ProjectKey* order = (ProjectKey*)malloc((num_projects + 1) * sizeof(ProjectKey));
+    if (!order) return 0;
+
+    // Filling the lists in min_experience order leaves each one sorted
+    for (int j = 0; j < num_projects; j++) {
+        order[j].min_experience = projects[j].min_experience;
+        order[j].project = j;
+        index->seen[j] = 0;
+    }
+    qsort(order, num_projects, sizeof(ProjectKey), compare_project_keys);
+
+    // Counts land two slots up so the fill below can bump start[s + 1]
+    int* start = index->posting_start;
+    memset(start, 0, skill_slots * sizeof(int));
+    for (int j = 0; j < num_projects; j++) {
+        for (int k = 0; k < projects[j].num_required_skills; k++) {
+            SkillId skill = projects[j].required_skill_ids[k];
+            if (skill < num_skills) start[skill + 2]++;
+        }
+    }
+    for (int s = 0; s < num_skills; s++) start[s + 2] += start[s + 1];
+    for (int o = 0; o < num_projects; o++) {
+        const Project* p = &projects[order[o].project];
+        for (int k = 0; k < p->num_required_skills; k++) {
+            SkillId skill = p->required_skill_ids[k];
+            if (skill >= num_skills) continue;
+            int slot = start[skill + 1]++;
+            index->posting[slot] = order[o].project;
+            index->posting_experience[slot] = p->min_experience;
+        }
+    }
+    index->num_skills = num_skills;
+    free(order);
+    return 1;
+}
+
+// Collect the projects on `skill`'s list that `limit` years of experience admit
+static int collect(CandidateIndex* index, SkillId skill, int limit, int stamp, int count) {
+    if (skill >= index->num_skills) return count;
+    int begin = index->posting_start[skill];
+    int end = index->posting_start[skill + 1];
+    if (limit < INT_MAX) {
+        // First entry whose min_experience is above the limit
+        int low = begin, high = end;
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (index->posting_experience[mid] <= limit) low = mid + 1;
+            else high = mid;
+        }
+        end = low;
+    }
+    for (int e = begin; e < end; e++) {
+        int project = index->posting[e];
+        if (index->seen[project] == stamp) continue;
+        index->seen[project] = stamp;
+        index->candidates[count++] = project;
+    }
+    return count;
+}
+
+int candidate_index_query(CandidateIndex* index, const Freelancer* freelancer, int row) {
+    // With a floor of p%, a project needs min_experience <= experience * 100 / p
+    int percent = min_experience_percent();
+    int limit = percent > 0 ? freelancer->experience * 100 / percent : INT_MAX;
+    int stamp = row + 1;
+    int count = 0;
+    for (int k = 0; k < freelancer->num_skills; k++) {
+        SkillId skill = freelancer->skill_ids[k];
+        if (skill == SKILL_ID_NONE) continue;
+        count = collect(index, skill, limit, stamp, count);
+        int similar_count;
+        const SkillId* similar = skill_similar(skill, &similar_count);
+        for (int s = 0; s < similar_count; s++) {
+            count = collect(index, similar[s], limit, stamp, count);
+        }
+    }
+    // Edges are added in project order, as the full scan did
+    qsort(index->candidates, count, sizeof(int), compare_ints);
+    return count;
+}
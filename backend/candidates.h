@@ -0,0 +1,35 @@
+#ifndef CANDIDATES_H
+#define CANDIDATES_H
+
+#include "utils.h"
+
+// Inverted index from skill id to the projects that require it. The graph
+// build asks it for the projects a freelancer can score above zero against
+// (those sharing a skill, or a similar one) instead of scoring all F x P
+// pairs. Each posting list is sorted by min_experience, so the experience
+// floor (set_min_experience_percent) cuts it with one binary search. The
+// buffers are kept and reused by the next build.
+typedef struct {
+    int num_skills;             // skill ids covered by posting_start
+    int* posting_start;         // posting list of skill s: [posting_start[s], posting_start[s + 1])
+    int* posting;               // project indices, ascending min_experience within a list
+    int* posting_experience;    // min_experience of each posting entry
+    int* seen;                  // per project: row that last collected it, plus one
+    int* candidates;            // result of the last query, ascending project index
+    int skill_capacity;
+    int posting_capacity;
+    int project_capacity;
+} CandidateIndex;
+
+void candidate_index_init(CandidateIndex* index);
+void candidate_index_free(CandidateIndex* index);
+
+// Index the projects' required skills. Returns 0 on allocation failure.
+int candidate_index_build(CandidateIndex* index, const Project* projects, int num_projects);
+
+// Collect into index->candidates the projects `freelancer` (row `row` of the
+// graph being built, rows queried in increasing order) may score above zero
+// against. Returns how many there are.
+int candidate_index_query(CandidateIndex* index, const Freelancer* freelancer, int row);
+
+#endif // CANDIDATES_H
@@ -0,0 +1,88 @@
+#include "compression.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <zlib.h>
+
+#define GZIP_WINDOW_BITS (15 + 16)   // zlib adds the gzip header and trailer
+#define DEFLATE_WINDOW_BITS 15       // HTTP "deflate" is the zlib format
+
+// q-value of one Accept-Encoding element, e.g. "gzip;q=0.5"
+static double element_quality(const char* element, size_t length) {
+    const char* params = memchr(element, ';', length);
+    if (!params) return 1.0;
+    const char* q = strstr(params, "q=");
+    if (!q || q >= element + length) return 1.0;
+    return atof(q + 2);
+}
+
+ContentEncoding negotiate_encoding(const char* accept_encoding) {
+    double gzip_quality = 0.0, deflate_quality = 0.0, any_quality = 0.0;
+    int gzip_listed = 0;
+    const char* element = accept_encoding;
+    while (*element) {
+        while (*element == ' ' || *element == ',') element++;
+        size_t length = strcspn(element, ",");
+        size_t token_length = strcspn(element, ";, ");
+        if (token_length > length) token_length = length;
+        double quality = element_quality(element, length);
+        if (token_length == 4 && strncasecmp(element, "gzip", 4) == 0) {
+            gzip_quality = quality;
+            gzip_listed = 1;
+        } else if (token_length == 7 && strncasecmp(element, "deflate", 7) == 0) {
+            deflate_quality = quality;
+        } else if (token_length == 1 && element[0] == '*') {
+            any_quality = quality;
+        }
+        element += length;
+    }
+    if (!gzip_listed) gzip_quality = any_quality;
+    if (gzip_quality > 0.0 && gzip_quality >= deflate_quality) return ENCODING_GZIP;
+    if (deflate_quality > 0.0) return ENCODING_DEFLATE;
+    return ENCODING_IDENTITY;
+}
+
+const char* encoding_name(ContentEncoding encoding) {
+    switch (encoding) {
+        case ENCODING_GZIP: return "gzip";
+        case ENCODING_DEFLATE: return "deflate";
+        default: return NULL;
+    }
+}
+
+int compress_body(const char* data, size_t length, ContentEncoding encoding,
+                  int level, CompressedBody* out) {
+    out->data = NULL;
+    out->length = 0;
+    if (encoding != ENCODING_GZIP && encoding != ENCODING_DEFLATE) return 0;
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    int window_bits = encoding == ENCODING_GZIP ? GZIP_WINDOW_BITS : DEFLATE_WINDOW_BITS;
+    if (deflateInit2(&stream, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return 0;
+    }
+
+    // One deflate call: deflateBound accounts for the wrapper chosen above
+    size_t capacity = deflateBound(&stream, length);
+    char* buffer = (char*)malloc(capacity);
+    if (!buffer) {
+        deflateEnd(&stream);
+        return 0;
+    }
+    stream.next_in = (Bytef*)data;
+    stream.avail_in = (uInt)length;
+    stream.next_out = (Bytef*)buffer;
+    stream.avail_out = (uInt)capacity;
+    int status = deflate(&stream, Z_FINISH);
+    size_t produced = stream.total_out;
+    deflateEnd(&stream);
+    if (status != Z_STREAM_END) {
+        free(buffer);
+        return 0;
+    }
+
+    out->data = buffer;
+    out->length = produced;
+    return 1;
+}
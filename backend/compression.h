@@ -0,0 +1,33 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <stddef.h>
+
+// Content codings the server can produce
+typedef enum {
+    ENCODING_IDENTITY,
+    ENCODING_GZIP,
+    ENCODING_DEFLATE,
+    ENCODING_COUNT
+} ContentEncoding;
+
+// Bodies smaller than this are sent uncompressed
+#define COMPRESS_MIN_BYTES 1024
+
+typedef struct {
+    char* data;
+    size_t length;
+} CompressedBody;
+
+// Pick the coding for an Accept-Encoding header value (gzip preferred over deflate)
+ContentEncoding negotiate_encoding(const char* accept_encoding);
+
+// Token for the Content-Encoding header, NULL for identity
+const char* encoding_name(ContentEncoding encoding);
+
+// Compress data with zlib at the given level (1-9). Returns 1 on success;
+// out->data is then owned by the caller.
+int compress_body(const char* data, size_t length, ContentEncoding encoding,
+                  int level, CompressedBody* out);
+
+#endif // COMPRESSION_H
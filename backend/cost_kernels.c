@@ -0,0 +1,278 @@
+#include "cost_kernels.h"
+#include <limits.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+
+// SSE2 lacks a 32-bit min/select, so build them from compare and masks
+static inline __m128i select_epi32(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i min_epi32(__m128i a, __m128i b) {
+    return select_epi32(_mm_cmplt_epi32(a, b), a, b);
+}
+
+// Sign-extend four int16 costs to int32
+static inline __m128i load_costs_epi32(const cost_t* costs) {
+    __m128i packed = _mm_loadl_epi64((const __m128i*)costs);
+    return _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+}
+
+static inline int horizontal_min_epi32(__m128i v) {
+    v = min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+
+int cost_row_min(const cost_t* row, int n) {
+    __m128i min_a = _mm_set1_epi16(COST_MAX);
+    __m128i min_b = min_a;
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+        min_a = _mm_min_epi16(min_a, _mm_loadu_si128((const __m128i*)(row + j)));
+        min_b = _mm_min_epi16(min_b, _mm_loadu_si128((const __m128i*)(row + j + 8)));
+    }
+    min_a = _mm_min_epi16(min_a, min_b);
+    min_a = _mm_min_epi16(min_a, _mm_shuffle_epi32(min_a, _MM_SHUFFLE(1, 0, 3, 2)));
+    min_a = _mm_min_epi16(min_a, _mm_shuffle_epi32(min_a, _MM_SHUFFLE(2, 3, 0, 1)));
+    min_a = _mm_min_epi16(min_a, _mm_shufflelo_epi16(min_a, _MM_SHUFFLE(2, 3, 0, 1)));
+    int min = (int16_t)_mm_extract_epi16(min_a, 0);
+    for (; j < n; j++) {
+        if (row[j] < min) min = row[j];
+    }
+    return min;
+}
+
+void cost_col_min_accumulate(const cost_t* row, int row_potential, cost_t* col_min, int n) {
+    __m128i potential = _mm_set1_epi16((int16_t)row_potential);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m128i reduced = _mm_subs_epi16(_mm_loadu_si128((const __m128i*)(row + j)), potential);
+        __m128i current = _mm_loadu_si128((const __m128i*)(col_min + j));
+        _mm_storeu_si128((__m128i*)(col_min + j), _mm_min_epi16(current, reduced));
+    }
+    for (; j < n; j++) {
+        int reduced = row[j] - row_potential;
+        if (reduced < col_min[j]) col_min[j] = (cost_t)reduced;
+    }
+}
+
+int cost_update_slack(const cost_t* row, int row_potential, const int* col_potential,
+                      int* min_slack, int* path, const int* col_used, int from_col, int n) {
+    __m128i potential = _mm_set1_epi32(row_potential);
+    __m128i from = _mm_set1_epi32(from_col);
+    __m128i infinity = _mm_set1_epi32(INT_MAX);
+    __m128i smallest = infinity;
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m128i reduced = _mm_sub_epi32(_mm_sub_epi32(load_costs_epi32(row + j), potential),
+                                        _mm_loadu_si128((const __m128i*)(col_potential + j)));
+        __m128i slack = _mm_loadu_si128((const __m128i*)(min_slack + j));
+        __m128i used = _mm_loadu_si128((const __m128i*)(col_used + j));
+        __m128i improves = _mm_andnot_si128(used, _mm_cmplt_epi32(reduced, slack));
+        slack = select_epi32(improves, reduced, slack);
+        _mm_storeu_si128((__m128i*)(min_slack + j), slack);
+        __m128i previous = _mm_loadu_si128((const __m128i*)(path + j));
+        _mm_storeu_si128((__m128i*)(path + j), select_epi32(improves, from, previous));
+        smallest = min_epi32(smallest, select_epi32(used, infinity, slack));
+    }
+    int min = horizontal_min_epi32(smallest);
+    for (; j < n; j++) {
+        if (col_used[j]) continue;
+        int reduced = row[j] - row_potential - col_potential[j];
+        if (reduced < min_slack[j]) {
+            min_slack[j] = reduced;
+            path[j] = from_col;
+        }
+        if (min_slack[j] < min) min = min_slack[j];
+    }
+    return min;
+}
+
+int cost_row_min_wide(const wide_cost_t* row, int n) {
+    __m128i min_a = _mm_set1_epi32(WIDE_COST_MAX);
+    __m128i min_b = min_a;
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        min_a = min_epi32(min_a, _mm_loadu_si128((const __m128i*)(row + j)));
+        min_b = min_epi32(min_b, _mm_loadu_si128((const __m128i*)(row + j + 4)));
+    }
+    int min = horizontal_min_epi32(min_epi32(min_a, min_b));
+    for (; j < n; j++) {
+        if (row[j] < min) min = row[j];
+    }
+    return min;
+}
+
+void cost_col_min_accumulate_wide(const wide_cost_t* row, int row_potential, int* col_min, int n) {
+    __m128i potential = _mm_set1_epi32(row_potential);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m128i reduced = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(row + j)), potential);
+        __m128i current = _mm_loadu_si128((const __m128i*)(col_min + j));
+        _mm_storeu_si128((__m128i*)(col_min + j), min_epi32(current, reduced));
+    }
+    for (; j < n; j++) {
+        int reduced = row[j] - row_potential;
+        if (reduced < col_min[j]) col_min[j] = reduced;
+    }
+}
+
+int cost_update_slack_wide(const wide_cost_t* row, int row_potential, const int* col_potential,
+                           int* min_slack, int* path, const int* col_used, int from_col, int n) {
+    __m128i potential = _mm_set1_epi32(row_potential);
+    __m128i from = _mm_set1_epi32(from_col);
+    __m128i infinity = _mm_set1_epi32(INT_MAX);
+    __m128i smallest = infinity;
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m128i reduced = _mm_sub_epi32(_mm_sub_epi32(_mm_loadu_si128((const __m128i*)(row + j)), potential),
+                                        _mm_loadu_si128((const __m128i*)(col_potential + j)));
+        __m128i slack = _mm_loadu_si128((const __m128i*)(min_slack + j));
+        __m128i used = _mm_loadu_si128((const __m128i*)(col_used + j));
+        __m128i improves = _mm_andnot_si128(used, _mm_cmplt_epi32(reduced, slack));
+        slack = select_epi32(improves, reduced, slack);
+        _mm_storeu_si128((__m128i*)(min_slack + j), slack);
+        __m128i previous = _mm_loadu_si128((const __m128i*)(path + j));
+        _mm_storeu_si128((__m128i*)(path + j), select_epi32(improves, from, previous));
+        smallest = min_epi32(smallest, select_epi32(used, infinity, slack));
+    }
+    int min = horizontal_min_epi32(smallest);
+    for (; j < n; j++) {
+        if (col_used[j]) continue;
+        int reduced = row[j] - row_potential - col_potential[j];
+        if (reduced < min_slack[j]) {
+            min_slack[j] = reduced;
+            path[j] = from_col;
+        }
+        if (min_slack[j] < min) min = min_slack[j];
+    }
+    return min;
+}
+
+int cost_find_slack(const int* min_slack, const int* col_used, const int* col_owner,
+                    int min, int n) {
+    __m128i target = _mm_set1_epi32(min);
+    int first = -1;
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(min_slack + j)), target);
+        equal = _mm_andnot_si128(_mm_loadu_si128((const __m128i*)(col_used + j)), equal);
+        int lanes = _mm_movemask_ps(_mm_castsi128_ps(equal));
+        while (lanes) {
+            int k = j + __builtin_ctz(lanes);
+            if (col_owner[k] == 0) return k;
+            if (first < 0) first = k;
+            lanes &= lanes - 1;
+        }
+    }
+    for (; j < n; j++) {
+        if (!col_used[j] && min_slack[j] == min) {
+            if (col_owner[j] == 0) return j;
+            if (first < 0) first = j;
+        }
+    }
+    return first;
+}
+
+void cost_shift_potentials(int* col_potential, int* min_slack, const int* col_used,
+                           int delta, int n) {
+    __m128i shift = _mm_set1_epi32(delta);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m128i used = _mm_loadu_si128((const __m128i*)(col_used + j));
+        __m128i potential = _mm_loadu_si128((const __m128i*)(col_potential + j));
+        __m128i slack = _mm_loadu_si128((const __m128i*)(min_slack + j));
+        _mm_storeu_si128((__m128i*)(col_potential + j), _mm_sub_epi32(potential, _mm_and_si128(used, shift)));
+        _mm_storeu_si128((__m128i*)(min_slack + j), _mm_sub_epi32(slack, _mm_andnot_si128(used, shift)));
+    }
+    for (; j < n; j++) {
+        if (col_used[j]) col_potential[j] -= delta;
+        else min_slack[j] -= delta;
+    }
+}
+
+#else // scalar fallback
+
+int cost_row_min(const cost_t* row, int n) {
+    int min = COST_MAX;
+    for (int j = 0; j < n; j++) {
+        if (row[j] < min) min = row[j];
+    }
+    return min;
+}
+
+void cost_col_min_accumulate(const cost_t* row, int row_potential, cost_t* col_min, int n) {
+    for (int j = 0; j < n; j++) {
+        int reduced = row[j] - row_potential;
+        if (reduced < col_min[j]) col_min[j] = (cost_t)reduced;
+    }
+}
+
+int cost_update_slack(const cost_t* row, int row_potential, const int* col_potential,
+                      int* min_slack, int* path, const int* col_used, int from_col, int n) {
+    int min = INT_MAX;
+    for (int j = 0; j < n; j++) {
+        if (col_used[j]) continue;
+        int reduced = row[j] - row_potential - col_potential[j];
+        if (reduced < min_slack[j]) {
+            min_slack[j] = reduced;
+            path[j] = from_col;
+        }
+        if (min_slack[j] < min) min = min_slack[j];
+    }
+    return min;
+}
+
+int cost_row_min_wide(const wide_cost_t* row, int n) {
+    int min = WIDE_COST_MAX;
+    for (int j = 0; j < n; j++) {
+        if (row[j] < min) min = row[j];
+    }
+    return min;
+}
+
+void cost_col_min_accumulate_wide(const wide_cost_t* row, int row_potential, int* col_min, int n) {
+    for (int j = 0; j < n; j++) {
+        int reduced = row[j] - row_potential;
+        if (reduced < col_min[j]) col_min[j] = reduced;
+    }
+}
+
+int cost_update_slack_wide(const wide_cost_t* row, int row_potential, const int* col_potential,
+                           int* min_slack, int* path, const int* col_used, int from_col, int n) {
+    int min = INT_MAX;
+    for (int j = 0; j < n; j++) {
+        if (col_used[j]) continue;
+        int reduced = row[j] - row_potential - col_potential[j];
+        if (reduced < min_slack[j]) {
+            min_slack[j] = reduced;
+            path[j] = from_col;
+        }
+        if (min_slack[j] < min) min = min_slack[j];
+    }
+    return min;
+}
+
+int cost_find_slack(const int* min_slack, const int* col_used, const int* col_owner,
+                    int min, int n) {
+    int first = -1;
+    for (int j = 0; j < n; j++) {
+        if (!col_used[j] && min_slack[j] == min) {
+            if (col_owner[j] == 0) return j;
+            if (first < 0) first = j;
+        }
+    }
+    return first;
+}
+
+void cost_shift_potentials(int* col_potential, int* min_slack, const int* col_used,
+                           int delta, int n) {
+    for (int j = 0; j < n; j++) {
+        if (col_used[j]) col_potential[j] -= delta;
+        else min_slack[j] -= delta;
+    }
+}
+
+#endif // __SSE2__
@@ -0,0 +1,48 @@
+#ifndef COST_KERNELS_H
+#define COST_KERNELS_H
+
+#include <stdint.h>
+
+// Solver costs are bounded (scores are 0-100), so the matrix is stored as
+// 16-bit values. Potentials and slacks stay 32-bit.
+typedef int16_t cost_t;
+#define COST_MAX INT16_MAX
+
+// Costs that do not fit 16 bits (fairness penalties need a score unit larger
+// than every penalty put together) use a 32-bit matrix instead
+typedef int32_t wide_cost_t;
+#define WIDE_COST_MAX INT32_MAX
+
+// Vectorised loops for the Hungarian solver. SSE2 is used when the compiler
+// targets it (always on x86-64) with a scalar fallback elsewhere. All arrays
+// are 0-based and n long.
+
+// Smallest entry of a row
+int cost_row_min(const cost_t* row, int n);
+
+// col_min[j] = min(col_min[j], row[j] - row_potential); called once per row so
+// the column pass streams the matrix in row order
+void cost_col_min_accumulate(const cost_t* row, int row_potential, cost_t* col_min, int n);
+
+// For every uncovered column (col_used[j] == 0) lower min_slack[j] to the
+// reduced cost row[j] - row_potential - col_potential[j], recording from_col
+// in path[j] when it improves. Returns the smallest uncovered slack.
+int cost_update_slack(const cost_t* row, int row_potential, const int* col_potential,
+                      int* min_slack, int* path, const int* col_used, int from_col, int n);
+
+// The same three loops over a 32-bit matrix; col_min is an int array here
+int cost_row_min_wide(const wide_cost_t* row, int n);
+void cost_col_min_accumulate_wide(const wide_cost_t* row, int row_potential, int* col_min, int n);
+int cost_update_slack_wide(const wide_cost_t* row, int row_potential, const int* col_potential,
+                           int* min_slack, int* path, const int* col_used, int from_col, int n);
+
+// First uncovered column whose slack equals min, preferring a free column
+// (col_owner[j] == 0). Returns -1 if none.
+int cost_find_slack(const int* min_slack, const int* col_used, const int* col_owner,
+                    int min, int n);
+
+// Covered columns: col_potential[j] -= delta; uncovered: min_slack[j] -= delta
+void cost_shift_potentials(int* col_potential, int* min_slack, const int* col_used,
+                           int delta, int n);
+
+#endif // COST_KERNELS_H
@@ -0,0 +1,107 @@
+#include <pthread.h>
+#include "fairness.h"
+#include "match_allocator.h"
+
+// History sorted by freelancer id. Solves on job threads read it while the
+// main thread records finished results, so it sits behind a lock.
+static FairnessCounter* history;
+static int history_count;
+static int history_capacity;
+static int weight_percent;
+static pthread_mutex_t fairness_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void fairness_set_weight(int percent) {
+    if (percent < 0) percent = 0;
+    if (percent > 100) percent = 100;
+    weight_percent = percent;
+}
+
+int fairness_weight(void) {
+    return weight_percent;
+}
+
+// Index of freelancer_id among the first `count` (sorted) records, or -1
+static int find_counter(int freelancer_id, int count) {
+    int low = 0, high = count - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        if (history[mid].freelancer_id == freelancer_id) return mid;
+        if (history[mid].freelancer_id < freelancer_id) low = mid + 1;
+        else high = mid - 1;
+    }
+    return -1;
+}
+
+static int compare_counters(const void* a, const void* b) {
+    int x = ((const FairnessCounter*)a)->freelancer_id;
+    int y = ((const FairnessCounter*)b)->freelancer_id;
+    return (x > y) - (x < y);
+}
+
+int fairness_penalties(const Freelancer* freelancers, int num_freelancers, uint8_t* penalty) {
+    if (weight_percent == 0) return 0;
+    pthread_mutex_lock(&fairness_lock);
+    for (int i = 0; i < num_freelancers; i++) {
+        int k = find_counter(freelancers[i].id, history_count);
+        int recent = k >= 0 ? history[k].recent : 0;
+        // Below ROW_PENALTY_SCALE at full weight
+        penalty[i] = (uint8_t)((ROW_PENALTY_SCALE - 1) * weight_percent * recent / (100 * 255));
+    }
+    pthread_mutex_unlock(&fairness_lock);
+    return 1;
+}
+
+void fairness_record(const Freelancer* freelancers, int num_freelancers,
+                     const int* freelancer_project) {
+    pthread_mutex_lock(&fairness_lock);
+    for (int k = 0; k < history_count; k++) {
+        history[k].recent /= 2;
+    }
+
+    // Existing records are bumped in place; new ones go on the end and the
+    // array is re-sorted once
+    int sorted_count = history_count;
+    for (int i = 0; i < num_freelancers; i++) {
+        if (freelancer_project[i] < 0) continue;
+        int k = find_counter(freelancers[i].id, sorted_count);
+        if (k < 0) {
+            if (history_count == history_capacity) {
+                int capacity = history_capacity ? history_capacity * 2 : 64;
+                FairnessCounter* grown = (FairnessCounter*)realloc(history, capacity * sizeof(FairnessCounter));
+                if (!grown) continue;
+                history = grown;
+                history_capacity = capacity;
+            }
+            k = history_count++;
+            memset(&history[k], 0, sizeof(history[k]));
+            history[k].freelancer_id = freelancers[i].id;
+        }
+        history[k].recent = (uint8_t)(history[k].recent + FAIRNESS_RECENT_BUMP);
+    }
+    if (history_count != sorted_count) {
+        qsort(history, history_count, sizeof(FairnessCounter), compare_counters);
+    }
+    pthread_mutex_unlock(&fairness_lock);
+}
+
+int fairness_export(FairnessCounter** counters) {
+    pthread_mutex_lock(&fairness_lock);
+    int count = history_count;
+    *counters = (FairnessCounter*)malloc((count + 1) * sizeof(FairnessCounter));
+    if (*counters) memcpy(*counters, history, count * sizeof(FairnessCounter));
+    pthread_mutex_unlock(&fairness_lock);
+    return *counters ? count : -1;
+}
+
+void fairness_import(const FairnessCounter* counters, int count) {
+    FairnessCounter* copy = (FairnessCounter*)malloc((count + 1) * sizeof(FairnessCounter));
+    if (!copy) return;
+    memcpy(copy, counters, count * sizeof(FairnessCounter));
+    qsort(copy, count, sizeof(FairnessCounter), compare_counters);
+    pthread_mutex_lock(&fairness_lock);
+    free(history);
+    history = copy;
+    history_count = count;
+    history_capacity = count + 1;
+    pthread_mutex_unlock(&fairness_lock);
+}
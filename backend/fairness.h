@@ -0,0 +1,39 @@
+#ifndef FAIRNESS_H
+#define FAIRNESS_H
+
+#include "utils.h"
+
+// Workload history across solves. Every freelancer that has been assigned
+// keeps a small counter record, looked up by freelancer id, so the history
+// survives rows being added or reordered in the CSV files. When fairness is
+// on, the exact solver adds a penalty for recently busy freelancers to their
+// costs (see SolverWorkspace.row_penalty).
+#define FAIRNESS_RECENT_BUMP 128   // added to `recent` when assigned, after halving
+
+typedef struct {
+    int32_t freelancer_id;
+    uint8_t recent;         // halves every solve, +FAIRNESS_RECENT_BUMP when assigned
+    uint8_t reserved[3];
+} FairnessCounter;
+
+// Penalty weight in percent: at 100 a freelancer assigned in every recent
+// solve gets the largest penalty; 0 (the default) turns fairness off
+void fairness_set_weight(int percent);
+int fairness_weight(void);
+
+// Per-row penalties for the solver, below ROW_PENALTY_SCALE (see
+// solver_cost_scale() for how they are weighed against score).
+// Returns 0 (and leaves penalty untouched) when fairness is off.
+int fairness_penalties(const Freelancer* freelancers, int num_freelancers, uint8_t* penalty);
+
+// Age every record and bump the freelancers with a project
+// (freelancer_project[i] >= 0) after a solve
+void fairness_record(const Freelancer* freelancers, int num_freelancers,
+                     const int* freelancer_project);
+
+// Copy of the history, sorted by freelancer id, for the snapshot. The caller
+// frees it; returns the count or -1 on allocation failure.
+int fairness_export(FairnessCounter** counters);
+void fairness_import(const FairnessCounter* counters, int count);
+
+#endif // FAIRNESS_H
@@ -0,0 +1,214 @@
+#include "jobs.h"
+#include "match_results.h"
+#include "match_allocator.h"
+#include "metrics.h"
+#include <pthread.h>
+
+typedef struct {
+    int id;                     // 0 for a free slot
+    uint64_t version;
+    JobState state;
+    int requesters;             // submitters that have not cancelled
+    SolveProgress progress;
+    MatchResult result;         // built by the worker
+    int result_ready;           // result built and not yet adopted
+    uint64_t submitted_ns;
+    uint64_t finished_ns;
+} Job;
+
+static Job jobs[MAX_JOBS];
+static int next_job_id = 1;
+static pthread_mutex_t jobs_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static const char* state_names[] = { "queued", "running", "done", "failed", "cancelled" };
+static const char* phase_names[] = { "queued", "load", "build_graph", "reduce", "augment", "format", "done" };
+
+static int job_finished(const Job* job) {
+    return job->state == JOB_DONE || job->state == JOB_FAILED || job->state == JOB_CANCELLED;
+}
+
+static Job* find_job(int job_id) {
+    for (int k = 0; k < MAX_JOBS; k++) {
+        if (jobs[k].id == job_id && job_id > 0) return &jobs[k];
+    }
+    return NULL;
+}
+
+// A free slot, else the oldest finished job whose result has been adopted
+static Job* claim_slot(void) {
+    Job* oldest = NULL;
+    for (int k = 0; k < MAX_JOBS; k++) {
+        Job* job = &jobs[k];
+        if (job->id == 0) return job;
+        if (job_finished(job) && !job->result_ready && (!oldest || job->id < oldest->id)) {
+            oldest = job;
+        }
+    }
+    return oldest;
+}
+
+static void* run_job(void* arg) {
+    Job* job = (Job*)arg;
+
+    SolverWorkspace workspace;
+    solver_workspace_init(&workspace);
+    workspace.progress = &job->progress;
+
+    pthread_mutex_lock(&jobs_lock);
+    job->state = JOB_RUNNING;
+    uint64_t version = job->version;
+    pthread_mutex_unlock(&jobs_lock);
+
+    MatchResult result;
+    int built = !solve_cancelled(&job->progress) &&
+                match_results_build(&result, version, &workspace);
+    solver_workspace_free(&workspace);
+
+    pthread_mutex_lock(&jobs_lock);
+    if (built) {
+        job->result = result;
+        job->result_ready = 1;
+        job->state = JOB_DONE;
+    } else {
+        job->state = solve_cancelled(&job->progress) ? JOB_CANCELLED : JOB_FAILED;
+    }
+    job->finished_ns = metrics_now_ns();
+    pthread_mutex_unlock(&jobs_lock);
+    return NULL;
+}
+
+int jobs_submit(uint64_t version, int already_solved, int* coalesced) {
+    *coalesced = 0;
+    pthread_mutex_lock(&jobs_lock);
+
+    // Join an unfinished solve of the same data
+    for (int k = 0; k < MAX_JOBS; k++) {
+        Job* job = &jobs[k];
+        if (job->id && job->version == version && !job_finished(job) &&
+            !solve_cancelled(&job->progress)) {
+            job->requesters++;
+            *coalesced = 1;
+            int id = job->id;
+            pthread_mutex_unlock(&jobs_lock);
+            return id;
+        }
+    }
+
+    Job* job = claim_slot();
+    if (!job) {
+        pthread_mutex_unlock(&jobs_lock);
+        return -1;
+    }
+    memset(job, 0, sizeof(*job));
+    job->id = next_job_id++;
+    job->version = version;
+    job->requesters = 1;
+    job->submitted_ns = metrics_now_ns();
+    int id = job->id;
+
+    if (already_solved) {
+        job->state = JOB_DONE;
+        atomic_store(&job->progress.phase, SOLVE_PHASE_DONE);
+        job->finished_ns = job->submitted_ns;
+        pthread_mutex_unlock(&jobs_lock);
+        return id;
+    }
+
+    job->state = JOB_QUEUED;
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, run_job, job) != 0) {
+        job->state = JOB_FAILED;
+        job->finished_ns = job->submitted_ns;
+    } else {
+        pthread_detach(thread);
+    }
+    pthread_mutex_unlock(&jobs_lock);
+    return id;
+}
+
+int jobs_active_for(uint64_t version) {
+    int id = 0;
+    pthread_mutex_lock(&jobs_lock);
+    for (int k = 0; k < MAX_JOBS; k++) {
+        if (jobs[k].id && jobs[k].version == version && !job_finished(&jobs[k]) &&
+            !solve_cancelled(&jobs[k].progress)) {
+            id = jobs[k].id;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&jobs_lock);
+    return id;
+}
+
+int jobs_cancel(int job_id) {
+    pthread_mutex_lock(&jobs_lock);
+    Job* job = find_job(job_id);
+    if (!job) {
+        pthread_mutex_unlock(&jobs_lock);
+        return 0;
+    }
+    if (!job_finished(job) && job->requesters > 0 && --job->requesters == 0) {
+        atomic_store(&job->progress.cancel_requested, 1);
+    }
+    pthread_mutex_unlock(&jobs_lock);
+    return 1;
+}
+
+char* jobs_status_json(int job_id) {
+    pthread_mutex_lock(&jobs_lock);
+    Job* job = find_job(job_id);
+    if (!job) {
+        pthread_mutex_unlock(&jobs_lock);
+        return NULL;
+    }
+
+    int phase = atomic_load(&job->progress.phase);
+    int rows_total = atomic_load(&job->progress.rows_total);
+    int augmentations = atomic_load(&job->progress.augmentations);
+    long objective = atomic_load(&job->progress.objective);
+    int cancelling = !job_finished(job) && solve_cancelled(&job->progress);
+    uint64_t end_ns = job_finished(job) ? job->finished_ns : metrics_now_ns();
+
+    double fraction = job->state == JOB_DONE ? 1.0 :
+                      phase == SOLVE_PHASE_AUGMENT && rows_total > 0 ? (double)augmentations / rows_total :
+                      0.0;
+
+    StringBuffer json;
+    strbuf_init(&json, 384);
+    strbuf_appendf(&json,
+                   "{\"job_id\":%d,\"status\":\"%s\",\"phase\":\"%s\",\"requesters\":%d,"
+                   "\"rows_total\":%d,\"augmentations\":%d,\"progress\":%.3f,\"objective\":%ld,"
+                   "\"elapsed_ms\":%.1f,\"dataset_version\":\"%016llx\"",
+                   job->id, cancelling ? "cancelling" : state_names[job->state], phase_names[phase],
+                   job->requesters, rows_total, augmentations, fraction, objective,
+                   (end_ns - job->submitted_ns) / 1e6, (unsigned long long)job->version);
+    if (job->state == JOB_DONE) {
+        strbuf_appendf(&json, ",\"result\":\"/matches\"");
+    }
+    strbuf_appendf(&json, "}");
+    pthread_mutex_unlock(&jobs_lock);
+    return strbuf_detach(&json);
+}
+
+int jobs_collect(void) {
+    // Take the finished results out of the table under the lock, then adopt
+    // them without it: adopting writes the snapshot, and status polls and
+    // new submissions should not wait on that
+    MatchResult finished[MAX_JOBS];
+    int count = 0;
+    pthread_mutex_lock(&jobs_lock);
+    for (int k = 0; k < MAX_JOBS; k++) {
+        Job* job = &jobs[k];
+        if (job->result_ready) {
+            finished[count++] = job->result;
+            job->result_ready = 0;
+        }
+    }
+    pthread_mutex_unlock(&jobs_lock);
+
+    int changed = 0;
+    for (int k = 0; k < count; k++) {
+        changed |= match_results_adopt(&finished[k]);
+    }
+    return changed;
+}
@@ -0,0 +1,39 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdint.h>
+
+// Background solves for the /jobs API. A job reads and solves the current CSV
+// files on its own thread and workspace; POSTs for a dataset version that
+// already has a queued or running job join it instead of starting another.
+#define MAX_JOBS 32
+
+typedef enum {
+    JOB_QUEUED,
+    JOB_RUNNING,
+    JOB_DONE,
+    JOB_FAILED,
+    JOB_CANCELLED
+} JobState;
+
+// Start (or join) a solve of dataset `version`. `already_solved` records an
+// immediately finished job when the cached result is current. Sets
+// *coalesced when an existing job was joined. Returns the job id, or -1 if
+// every slot holds an unfinished job.
+int jobs_submit(uint64_t version, int already_solved, int* coalesced);
+
+// Id of the unfinished job solving `version`, or 0
+int jobs_active_for(uint64_t version);
+
+// Drop one requester of a job; the solve is cancelled when none remain.
+// Returns 0 if the job is unknown.
+int jobs_cancel(int job_id);
+
+// Status and progress as JSON; NULL if the job is unknown. Caller frees.
+char* jobs_status_json(int job_id);
+
+// Hand finished results to match_results. Main thread only; returns 1 if the
+// cached result changed.
+int jobs_collect(void);
+
+#endif // JOBS_H
@@ -2,11 +2,21 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <strings.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include "utils.h"
 #include "match_allocator.h"
 #include "bloom_filter_utils.h"
+#include "scheduler.h"
+#include "metrics.h"
+#include "match_results.h"
+#include "wire_format.h"
+#include "compression.h"
+#include "jobs.h"
+#include "shard.h"
+#include "skills.h"
+#include "fairness.h"
 
 #define PORT 8080
 #define BUFFER_SIZE 1024
@@ -29,85 +39,333 @@ void print_header(const char* text) {
 // Global Bloom filter for skills
 static GlobalBloom global_bloom = {0};
 
+// Rebuild the Bloom filter from a freshly solved dataset
+static void refresh_bloom(const MatchResult* result) {
+    uint64_t stage_start = metrics_now_ns();
+    global_bloom.initialized = 0;
+    populate_bloom_with_freelancer_skills(&global_bloom, result->freelancers,
+                                          result->num_freelancers);
+    metrics_observe_stage(STAGE_BLOOM, metrics_now_ns() - stage_start);
+}
+
+// Pick up results of finished background solves
+static void collect_jobs(void) {
+    if (jobs_collect()) {
+        int refreshed = 0;
+        const MatchResult* result = match_results_current(&refreshed);
+        if (result) refresh_bloom(result);
+    }
+}
+
+// Send a complete response with the standard headers
+static void send_response(int client_socket, const char* status, const char* content_type,
+                          const char* body, size_t length) {
+    char headers[BUFFER_SIZE];
+    snprintf(headers, sizeof(headers),
+            "HTTP/1.1 %s\r\n"
+            "Content-Type: %s\r\n"
+            "Access-Control-Allow-Origin: *\r\n"
+            "Content-Length: %zu\r\n"
+            "Connection: close\r\n\r\n",
+            status, content_type, length);
+    write(client_socket, headers, strlen(headers));
+    write(client_socket, body, length);
+}
+
+// Send a 200 response whose body may be compressed. The plain body is used
+// when `compressed` is NULL or empty.
+static void send_negotiated_response(int client_socket, const char* content_type,
+                                     const char* body, size_t length,
+                                     ContentEncoding encoding, const CompressedBody* compressed) {
+    const char* coding = compressed && compressed->data ? encoding_name(encoding) : NULL;
+    char content_encoding[64] = "";
+    if (coding) {
+        snprintf(content_encoding, sizeof(content_encoding), "Content-Encoding: %s\r\n", coding);
+        body = compressed->data;
+        length = compressed->length;
+    }
+    char headers[BUFFER_SIZE];
+    snprintf(headers, sizeof(headers),
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: %s\r\n"
+            "%s"
+            "Vary: Accept-Encoding\r\n"
+            "Access-Control-Allow-Origin: *\r\n"
+            "Content-Length: %zu\r\n"
+            "Connection: close\r\n\r\n",
+            content_type, content_encoding, length);
+    write(client_socket, headers, strlen(headers));
+    write(client_socket, body, length);
+}
+
+// Copy the value of request header `name` into `value`.
+// Returns 1 if the header is present.
+static int header_value(const char* request, const char* name, char* value, size_t size) {
+    size_t name_length = strlen(name);
+    const char* line = strstr(request, "\r\n");
+    while (line && line[2] != '\r' && line[2] != '\0') {
+        line += 2;
+        if (strncasecmp(line, name, name_length) == 0 && line[name_length] == ':') {
+            const char* start = line + name_length + 1;
+            while (*start == ' ' || *start == '\t') start++;
+            size_t length = strcspn(start, "\r\n");
+            if (length >= size) length = size - 1;
+            memcpy(value, start, length);
+            value[length] = '\0';
+            return 1;
+        }
+        line = strstr(line, "\r\n");
+    }
+    return 0;
+}
+
+// Copy the value of query parameter `name` from `path` into `value`.
+// Returns 1 if the parameter is present.
+static int query_param(const char* path, const char* name, char* value, size_t size) {
+    const char* query = strchr(path, '?');
+    size_t name_length = strlen(name);
+    while (query) {
+        query++;
+        if (strncmp(query, name, name_length) == 0 && query[name_length] == '=') {
+            const char* start = query + name_length + 1;
+            size_t length = strcspn(start, "&");
+            if (length >= size) length = size - 1;
+            memcpy(value, start, length);
+            value[length] = '\0';
+            return 1;
+        }
+        query = strchr(query, '&');
+    }
+    return 0;
+}
+
 // Function to handle HTTP requests
 void handle_request(int client_socket) {
     char buffer[BUFFER_SIZE];
     char response[BUFFER_SIZE * 2];
+    uint64_t request_start = metrics_now_ns();
     
     // Read the request
-    read(client_socket, buffer, BUFFER_SIZE);
+    ssize_t received = read(client_socket, buffer, BUFFER_SIZE - 1);
+    buffer[received > 0 ? received : 0] = '\0';
     
     // Parse the request method and path
-    char method[10], path[100];
-    sscanf(buffer, "%s %s", method, path);
+    char method[10] = "", path[256] = "";
+    sscanf(buffer, "%9s %255s", method, path);
+    
+    // Route on the path without its query string
+    char route[256];
+    size_t route_length = strcspn(path, "?");
+    memcpy(route, path, route_length);
+    route[route_length] = '\0';
     
     // Handle CORS preflight request
     if (strcmp(method, "OPTIONS") == 0) {
         const char* cors_headers = 
             "HTTP/1.1 204 No Content\r\n"
             "Access-Control-Allow-Origin: *\r\n"
-            "Access-Control-Allow-Methods: GET, OPTIONS\r\n"
+            "Access-Control-Allow-Methods: GET, POST, DELETE, OPTIONS\r\n"
             "Access-Control-Allow-Headers: Content-Type\r\n"
             "Access-Control-Max-Age: 86400\r\n"
             "Content-Length: 0\r\n"
             "Connection: close\r\n\r\n";
         write(client_socket, cors_headers, strlen(cors_headers));
         close(client_socket);
+        metrics_count_request(ENDPOINT_OPTIONS);
+        metrics_observe_stage(STAGE_REQUEST_TOTAL, metrics_now_ns() - request_start);
         return;
     }
     
-    // Handle GET request for /matches
-    if (strcmp(method, "GET") == 0 && strcmp(path, "/matches") == 0) {
+    // Handle GET request for /matches and /matches/summary
+    if (strcmp(method, "GET") == 0 &&
+        (strcmp(route, "/matches") == 0 || strcmp(route, "/matches/summary") == 0)) {
+        int summary = strcmp(route, "/matches/summary") == 0;
+        metrics_count_request(summary ? ENDPOINT_MATCHES_SUMMARY : ENDPOINT_MATCHES);
+        
+        collect_jobs();
+        char mode_param[16];
+        int greedy = !summary && query_param(path, "mode", mode_param, sizeof(mode_param)) &&
+                     strcmp(mode_param, "greedy") == 0;
+        if (greedy) {
+            // Latency-critical callers: approximate answer with its optimality gap
+            char* body = match_results_greedy_json();
+            if (body) {
+                send_response(client_socket, "200 OK", "application/json", body, strlen(body));
+                free(body);
+            } else {
+                const char* error = "{\"error\":\"Could not load data\"}";
+                send_response(client_socket, "500 Internal Server Error", "application/json",
+                              error, strlen(error));
+            }
+            close(client_socket);
+            metrics_observe_stage(STAGE_REQUEST_TOTAL, metrics_now_ns() - request_start);
+            return;
+        }
+        
+        // A background job already solving this data answers instead of a second solve
+        uint64_t version = dataset_version();
+        int active_job = match_results_is_current(version) ? 0 : jobs_active_for(version);
+        char* job_status = active_job ? jobs_status_json(active_job) : NULL;
+        if (job_status) {
+            send_response(client_socket, "202 Accepted", "application/json",
+                          job_status, strlen(job_status));
+            free(job_status);
+            close(client_socket);
+            metrics_observe_stage(STAGE_REQUEST_TOTAL, metrics_now_ns() - request_start);
+            return;
+        }
+        
+        // Re-reads and re-solves only when the CSV files have changed
+        int refreshed = 0;
+        const MatchResult* result = match_results_current(&refreshed);
+        if (!result) {
+            const char* error = "{\"error\":\"Could not load data\"}";
+            send_response(client_socket, "500 Internal Server Error", "application/json",
+                          error, strlen(error));
+            close(client_socket);
+            metrics_observe_stage(STAGE_REQUEST_TOTAL, metrics_now_ns() - request_start);
+            return;
+        }
+        
+        // Rebuild the Bloom filter whenever the freelancers may have changed
+        if (refreshed) {
+            refresh_bloom(result);
+        }
+        
+        char offset_param[16], limit_param[16], fields_param[128];
+        int has_offset = query_param(path, "offset", offset_param, sizeof(offset_param));
+        int has_limit = query_param(path, "limit", limit_param, sizeof(limit_param));
+        int has_fields = query_param(path, "fields", fields_param, sizeof(fields_param));
+        int fields = has_fields ? parse_match_fields(fields_param) : FIELDS_DEFAULT;
+        char accept_encoding[256];
+        ContentEncoding encoding = ENCODING_IDENTITY;
+        if (header_value(buffer, "Accept-Encoding", accept_encoding, sizeof(accept_encoding))) {
+            encoding = negotiate_encoding(accept_encoding);
+        }
+        char accept[256];
+        int wants_binary = header_value(buffer, "Accept", accept, sizeof(accept)) &&
+                           strstr(accept, WIRE_CONTENT_TYPE) != NULL;
+        
+        uint64_t stage_start = metrics_now_ns();
+        if (summary) {
+            send_negotiated_response(client_socket, "application/json",
+                                     result->summary_json, result->summary_json_length,
+                                     encoding, &result->summary_json_compressed[encoding]);
+        } else if (fields == 0) {
+            const char* error = "{\"error\":\"Unknown field in fields parameter\"}";
+            send_response(client_socket, "400 Bad Request", "application/json",
+                          error, strlen(error));
+        } else if (wants_binary) {
+            // Compact records straight from the assignment array
+            int offset = has_offset ? atoi(offset_param) : 0;
+            int limit = has_limit ? atoi(limit_param) : -1;
+            wire_send_matches(client_socket, result, offset, limit, fields != FIELDS_IDS);
+        } else if (has_offset || has_limit || has_fields) {
+            // A page of entries, formatted per request
+            int offset = has_offset ? atoi(offset_param) : 0;
+            int limit = has_limit ? atoi(limit_param) : -1;
+            char* page = format_matches_page_json(result, offset, limit, fields);
+            size_t page_length = strlen(page);
+            
+            // Pages are compressed per request at the fastest level
+            CompressedBody compressed = { NULL, 0 };
+            if (encoding != ENCODING_IDENTITY && page_length >= COMPRESS_MIN_BYTES) {
+                uint64_t compress_start = metrics_now_ns();
+                compress_body(page, page_length, encoding, 1, &compressed);
+                metrics_observe_stage(STAGE_COMPRESS, metrics_now_ns() - compress_start);
+            }
+            send_negotiated_response(client_socket, "application/json", page, page_length,
+                                     encoding, &compressed);
+            free(compressed.data);
+            free(page);
+        } else {
+            // The full listing is formatted once per solve
+            send_negotiated_response(client_socket, "application/json",
+                                     result->full_json, result->full_json_length,
+                                     encoding, &result->full_json_compressed[encoding]);
+        }
+        metrics_observe_stage(STAGE_WRITE_RESPONSE, metrics_now_ns() - stage_start);
+    } else if (strcmp(method, "POST") == 0 && strcmp(route, "/jobs") == 0) {
+        // Start a background solve of the current data, or join the one running
+        metrics_count_request(ENDPOINT_JOBS);
+        collect_jobs();
+        uint64_t version = dataset_version();
+        int coalesced = 0;
+        int job_id = jobs_submit(version, match_results_is_current(version), &coalesced);
+        char* job_status = job_id > 0 ? jobs_status_json(job_id) : NULL;
+        if (job_status) {
+            send_response(client_socket, coalesced ? "200 OK" : "202 Accepted", "application/json",
+                          job_status, strlen(job_status));
+            free(job_status);
+        } else {
+            const char* error = "{\"error\":\"Too many jobs in progress\"}";
+            send_response(client_socket, "503 Service Unavailable", "application/json",
+                          error, strlen(error));
+        }
+    } else if ((strcmp(method, "GET") == 0 || strcmp(method, "DELETE") == 0) &&
+               strncmp(route, "/jobs/", 6) == 0) {
+        // Poll or cancel a job
+        metrics_count_request(ENDPOINT_JOBS);
+        int job_id = atoi(route + 6);
+        if (strcmp(method, "DELETE") == 0) {
+            jobs_cancel(job_id);
+        } else {
+            collect_jobs();
+        }
+        char* job_status = jobs_status_json(job_id);
+        if (job_status) {
+            send_response(client_socket, "200 OK", "application/json",
+                          job_status, strlen(job_status));
+            free(job_status);
+        } else {
+            const char* error = "{\"error\":\"Unknown job\"}";
+            send_response(client_socket, "404 Not Found", "application/json",
+                          error, strlen(error));
+        }
+    } else if (strcmp(method, "GET") == 0 && strcmp(route, "/metrics") == 0) {
+        metrics_count_request(ENDPOINT_METRICS);
+        char* metrics_response = metrics_format_prometheus(
+            global_bloom.initialized ? bloom_fill_ratio(&global_bloom.filter) : 0.0);
+        
+        send_response(client_socket, "200 OK", "text/plain; version=0.0.4",
+                      metrics_response, strlen(metrics_response));
+        
+        free(metrics_response);
+    } else if (strcmp(method, "GET") == 0 && strcmp(route, "/schedule") == 0) {
         Freelancer freelancers[MAX_FREELANCERS];
         Project projects[MAX_PROJECTS];
         int num_freelancers = 0;
         int num_projects = 0;
-        Assignment assignments[MAX_FREELANCERS];
+        ScheduledAssignment schedule[MAX_FREELANCERS];
+        metrics_count_request(ENDPOINT_SCHEDULE);
         
         // Read data from CSV files
-        read_freelancers("../data/freelancers.csv", freelancers, &num_freelancers);
-        read_projects("../data/projects.csv", projects, &num_projects);
-        read_availability("../data/availability.csv", freelancers, num_freelancers);
-        // Populate Bloom filter with all freelancer skills
-        populate_bloom_with_freelancer_skills(&global_bloom, freelancers, num_freelancers);
-        
-        // Perform matching
-        match_freelancers_to_projects(freelancers, num_freelancers,
-                                    projects, num_projects,
-                                    assignments);
+        read_freelancers(FREELANCERS_CSV, freelancers, &num_freelancers);
+        read_projects(PROJECTS_CSV, projects, &num_projects);
+        read_availability(AVAILABILITY_CSV, freelancers, num_freelancers);
         
-        // Format the response as JSON
-        char* json_response = format_matches_json(freelancers, num_freelancers,
-                                                projects, num_projects,
-                                                assignments);
+        // Schedule within availability and deadlines
+        int num_scheduled = schedule_freelancers_to_projects(freelancers, num_freelancers,
+                                                             projects, num_projects,
+                                                             schedule);
         
-        // Send the response headers
-        char headers[BUFFER_SIZE];
-        snprintf(headers, sizeof(headers),
-                "HTTP/1.1 200 OK\r\n"
-                "Content-Type: application/json\r\n"
-                "Access-Control-Allow-Origin: *\r\n"
-                "Content-Length: %zu\r\n"
-                "Connection: close\r\n\r\n",
-                strlen(json_response));
+        char* json_response = format_schedule_json(freelancers, num_freelancers,
+                                                   projects, num_projects,
+                                                   schedule, num_scheduled);
         
-        write(client_socket, headers, strlen(headers));
-        
-        // Send the JSON body
-        write(client_socket, json_response, strlen(json_response));
+        send_response(client_socket, "200 OK", "application/json",
+                      json_response, strlen(json_response));
         
         free(json_response);
-    } else if (strcmp(method, "GET") == 0 && strncmp(path, "/freelancers_with_skill", 21) == 0) {
+    } else if (strcmp(method, "GET") == 0 && strcmp(route, "/freelancers_with_skill") == 0) {
         // Parse skill from query string
-        char* skill_param = strstr(path, "?skill=");
         char skill[100] = "";
-        if (skill_param) {
-            strncpy(skill, skill_param + 7, sizeof(skill) - 1);
-            skill[sizeof(skill) - 1] = '\0';
-        }
+        query_param(path, "skill", skill, sizeof(skill));
+        metrics_count_request(ENDPOINT_FREELANCERS_WITH_SKILL);
         Freelancer freelancers[MAX_FREELANCERS];
         int num_freelancers = 0;
-        read_freelancers("../data/freelancers.csv", freelancers, &num_freelancers);
+        read_freelancers(FREELANCERS_CSV, freelancers, &num_freelancers);
+        SkillId skill_id = skill_lookup(skill);
         // Build JSON array of freelancers with the skill
         char json_response[BUFFER_SIZE * 8];
         int pos = 0;
@@ -116,7 +374,7 @@ void handle_request(int client_socket) {
         for (int i = 0; i < num_freelancers; i++) {
             int found = 0;
             for (int j = 0; j < freelancers[i].num_skills; j++) {
-                if (strcmp(freelancers[i].skills[j], skill) == 0) {
+                if (skill_id != SKILL_ID_NONE && freelancers[i].skill_ids[j] == skill_id) {
                     found = 1;
                     break;
                 }
@@ -135,55 +393,73 @@ void handle_request(int client_socket) {
             }
         }
         pos += snprintf(json_response + pos, sizeof(json_response) - pos, "]");
-        char headers[BUFFER_SIZE];
-        snprintf(headers, sizeof(headers),
-            "HTTP/1.1 200 OK\r\n"
-            "Content-Type: application/json\r\n"
-            "Access-Control-Allow-Origin: *\r\n"
-            "Content-Length: %zu\r\n"
-            "Connection: close\r\n\r\n",
-            strlen(json_response));
-        write(client_socket, headers, strlen(headers));
-        write(client_socket, json_response, strlen(json_response));
-    } else if (strcmp(method, "GET") == 0 && strncmp(path, "/skill_exists", 13) == 0) {
+        send_response(client_socket, "200 OK", "application/json",
+                      json_response, strlen(json_response));
+    } else if (strcmp(method, "GET") == 0 && strcmp(route, "/skill_exists") == 0) {
         // Parse skill from query string
-        char* skill_param = strstr(path, "?skill=");
         char skill[100] = "";
-        if (skill_param) {
-            strncpy(skill, skill_param + 7, sizeof(skill) - 1);
-            skill[sizeof(skill) - 1] = '\0';
-        }
+        query_param(path, "skill", skill, sizeof(skill));
+        metrics_count_request(ENDPOINT_SKILL_EXISTS);
         int possibly_exists = 0;
         if (strlen(skill) > 0) {
-            possibly_exists = bloom_check(&global_bloom.filter, skill);
+            char canonical[MAX_SKILL_LENGTH];
+            skill_canonical(skill, canonical, sizeof(canonical));
+            possibly_exists = bloom_check(&global_bloom.filter, canonical);
         }
         char json_response[128];
         snprintf(json_response, sizeof(json_response),
             "{\"skill\":\"%s\",\"possibly_exists\":%s}",
             skill, possibly_exists ? "true" : "false");
-        char headers[BUFFER_SIZE];
-        snprintf(headers, sizeof(headers),
-            "HTTP/1.1 200 OK\r\n"
-            "Content-Type: application/json\r\n"
-            "Access-Control-Allow-Origin: *\r\n"
-            "Content-Length: %zu\r\n"
-            "Connection: close\r\n\r\n",
-            strlen(json_response));
-        write(client_socket, headers, strlen(headers));
-        write(client_socket, json_response, strlen(json_response));
+        send_response(client_socket, "200 OK", "application/json",
+                      json_response, strlen(json_response));
+    } else if (strcmp(method, "GET") == 0 && strcmp(route, "/explain") == 0) {
+        // Why a freelancer did or did not get a project, from the stored duals
+        metrics_count_request(ENDPOINT_EXPLAIN);
+        char freelancer_param[16] = "", project_param[16] = "";
+        if (!query_param(path, "freelancer", freelancer_param, sizeof(freelancer_param)) ||
+            !query_param(path, "project", project_param, sizeof(project_param))) {
+            const char* error = "{\"error\":\"freelancer and project are required\"}";
+            send_response(client_socket, "400 Bad Request", "application/json",
+                          error, strlen(error));
+        } else {
+            collect_jobs();
+            uint64_t version = dataset_version();
+            int active_job = match_results_is_current(version) ? 0 : jobs_active_for(version);
+            char* job_status = active_job ? jobs_status_json(active_job) : NULL;
+            int refreshed = 0;
+            const MatchResult* result = job_status ? NULL : match_results_current(&refreshed);
+            if (refreshed) {
+                refresh_bloom(result);
+            }
+            char* body = result ? match_results_explain_json(result, atoi(freelancer_param),
+                                                             atoi(project_param)) : NULL;
+            if (job_status) {
+                send_response(client_socket, "202 Accepted", "application/json",
+                              job_status, strlen(job_status));
+            } else if (!result) {
+                const char* error = "{\"error\":\"Could not load data\"}";
+                send_response(client_socket, "500 Internal Server Error", "application/json",
+                              error, strlen(error));
+            } else if (!body) {
+                const char* error = "{\"error\":\"Unknown freelancer or project\"}";
+                send_response(client_socket, "404 Not Found", "application/json",
+                              error, strlen(error));
+            } else {
+                send_response(client_socket, "200 OK", "application/json", body, strlen(body));
+            }
+            free(job_status);
+            free(body);
+        }
     } else {
+        metrics_count_request(ENDPOINT_NOT_FOUND);
         // Handle 404 Not Found
-        const char* not_found = 
-            "HTTP/1.1 404 Not Found\r\n"
-            "Content-Type: application/json\r\n"
-            "Access-Control-Allow-Origin: *\r\n"
-            "Content-Length: 28\r\n"
-            "Connection: close\r\n\r\n"
-            "{\"error\":\"Resource not found\"}";
-        write(client_socket, not_found, strlen(not_found));
+        const char* not_found = "{\"error\":\"Resource not found\"}";
+        send_response(client_socket, "404 Not Found", "application/json",
+                      not_found, strlen(not_found));
     }
     
     close(client_socket);
+    metrics_observe_stage(STAGE_REQUEST_TOTAL, metrics_now_ns() - request_start);
 }
 
 int main() {
@@ -192,6 +468,15 @@ int main() {
     int opt = 1;
     int addrlen = sizeof(address);
     
+    // FREELANCER_WORKERS=N forks N solver processes for problems with more than
+    // FREELANCER_SHARD_NODES (default 2048) freelancers or projects. They are
+    // forked first so they inherit neither the listening socket nor threads.
+    const char* workers_setting = getenv("FREELANCER_WORKERS");
+    if (workers_setting && atoi(workers_setting) > 0) {
+        const char* shard_setting = getenv("FREELANCER_SHARD_NODES");
+        shard_pool_start(atoi(workers_setting), shard_setting ? atoi(shard_setting) : 0);
+    }
+    
     // Create socket
     if ((server_fd = socket(AF_INET, SOCK_STREAM, 0)) == 0) {
         perror("socket failed");
@@ -220,6 +505,47 @@ int main() {
         exit(EXIT_FAILURE);
     }
     
+    // FREELANCER_METRICS=0 turns the stage timers and counters off
+    const char* metrics_setting = getenv("FREELANCER_METRICS");
+    if (metrics_setting && strcmp(metrics_setting, "0") == 0) {
+        metrics_set_enabled(0);
+    }
+    
+    // Skill aliases and partial-credit similarities, before any CSV is read.
+    // FREELANCER_SKILL_ALIASES overrides the alias file (empty to disable);
+    // FREELANCER_SKILL_SIMILARITY names an optional similarity file.
+    const char* aliases_setting = getenv("FREELANCER_SKILL_ALIASES");
+    if (!aliases_setting) aliases_setting = SKILL_ALIASES_FILE;
+    if (aliases_setting[0] && skills_load_aliases(aliases_setting) < 0) {
+        printf("No skill alias file at %s\n", aliases_setting);
+    }
+    const char* similarity_setting = getenv("FREELANCER_SKILL_SIMILARITY");
+    if (similarity_setting && similarity_setting[0]) {
+        skills_load_similarity(similarity_setting);
+    }
+    
+    // FREELANCER_MIN_EXPERIENCE_PERCENT=p drops pairs where the freelancer has
+    // under p% of the project's min_experience (default 0, none dropped)
+    const char* experience_setting = getenv("FREELANCER_MIN_EXPERIENCE_PERCENT");
+    if (experience_setting) {
+        set_min_experience_percent(atoi(experience_setting));
+    }
+    
+    // FREELANCER_FAIRNESS=w (0-100) nudges ties away from freelancers assigned
+    // in recent solves; the history is kept in the snapshot (default 0, off)
+    const char* fairness_setting = getenv("FREELANCER_FAIRNESS");
+    if (fairness_setting) {
+        fairness_set_weight(atoi(fairness_setting));
+    }
+    
+    // Restore the last solve so the first request does not pay for it
+    const char* snapshot_setting = getenv("FREELANCER_SNAPSHOT");
+    match_results_set_snapshot_path(snapshot_setting ? snapshot_setting : SNAPSHOT_FILE);
+    if (match_results_warm_start()) {
+        int refreshed = 0;
+        refresh_bloom(match_results_current(&refreshed));
+    }
+    
     printf("Server listening on port %d...\n", PORT);
     
     // Accept connections
@@ -3,286 +3,730 @@
 #include <string.h>
 #include <limits.h>
 #include "match_allocator.h"
+#include "metrics.h"
+#include "shard.h"
+#include "skills.h"
 
 #define INF INT_MAX
+// Pairs without an edge cost the same as a zero score, so leaving a freelancer
+// unassigned is never worse than a real match and the padded square problem
+// maximises the total score
+#define NO_EDGE_COST MAX_SCORE
+#define WORKSPACE_ALIGNMENT 64
 
-// Helper function to find the minimum value in a row
-static int find_min_in_row(const int* row, int n) {
-    int min = INF;
-    for (int i = 0; i < n; i++) {
-        if (row[i] < min) {
-            min = row[i];
-        }
-    }
-    return min;
+// Process-wide workspace used by match_freelancers_to_projects()
+static SolverWorkspace shared_workspace;
+
+// Entry `index` of the cost matrix, which holds wide_cost_t entries when the
+// last solve's scale did not fit cost_t
+static inline int cost_at(const SolverWorkspace* workspace, size_t index) {
+    return workspace->wide ? ((const wide_cost_t*)workspace->cost)[index] : workspace->cost[index];
 }
 
-// Helper function to find the minimum value in a column
-static int find_min_in_col(const int** cost_matrix, int col, int n) {
-    int min = INF;
-    for (int i = 0; i < n; i++) {
-        if (cost_matrix[i][col] < min) {
-            min = cost_matrix[i][col];
+// Helper function to find the minimum value in row i
+static int find_min_in_row(const SolverWorkspace* workspace, int i, int n) {
+    size_t offset = (size_t)i * workspace->stride;
+    return workspace->wide ? cost_row_min_wide((const wide_cost_t*)workspace->cost + offset, n) :
+                             cost_row_min(workspace->cost + offset, n);
+}
+
+// Helper function to find the minimum of every column after the row
+// potentials have been taken off; rows are streamed in memory order
+static void find_min_in_cols(SolverWorkspace* workspace, int n, const int* row_potential,
+                             int* col_potential) {
+    size_t stride = workspace->stride;
+    if (workspace->wide) {
+        // The 16-bit accumulator cannot hold wide costs; min_slack is free until augmenting
+        int* col_min = workspace->min_slack;
+        for (int j = 0; j < n; j++) {
+            col_min[j] = INF;
+        }
+        for (int i = 0; i < n; i++) {
+            cost_col_min_accumulate_wide((const wide_cost_t*)workspace->cost + i * stride,
+                                         row_potential[i + 1], col_min, n);
+        }
+        for (int j = 0; j < n; j++) {
+            col_potential[j + 1] = col_min[j];
         }
+        return;
+    }
+    cost_t* col_min = workspace->col_min;
+    for (int j = 0; j < n; j++) {
+        col_min[j] = COST_MAX;
+    }
+    for (int i = 0; i < n; i++) {
+        cost_col_min_accumulate(workspace->cost + i * stride, row_potential[i + 1], col_min, n);
+    }
+    for (int j = 0; j < n; j++) {
+        col_potential[j + 1] = col_min[j];
     }
-    return min;
 }
 
-// Helper function to find a zero in the matrix
-static int find_zero(const int** cost_matrix, int n, int* row, int* col,
-                    const int* row_cover, const int* col_cover) {
-    for (int i = 0; i < n; i++) {
-        if (!row_cover[i]) {
-            for (int j = 0; j < n; j++) {
-                if (!col_cover[j] && cost_matrix[i][j] == 0) {
-                    *row = i;
-                    *col = j;
-                    return 1;
-                }
+// Helper function to find the uncovered column holding the smallest slack
+// (1-based). Ties go to a free column, which ends the search straight away;
+// scores are bounded so ties are common.
+static int find_min_uncovered(int min, const int* min_slack, const int* col_used,
+                              const int* col_owner, int n) {
+    return cost_find_slack(min_slack + 1, col_used + 1, col_owner + 1, min, n) + 1;
+}
+
+// Helper function to pair rows with free columns on tight (zero reduced
+// cost) entries before augmenting; row_match holds 1-based columns
+static void cover_zeros(const SolverWorkspace* workspace, int n, const int* row_potential,
+                        const int* col_potential, int* row_match, int* col_owner) {
+    for (int i = 1; i <= n; i++) {
+        size_t row = (size_t)(i - 1) * workspace->stride;
+        for (int j = 1; j <= n; j++) {
+            if (!col_owner[j] && cost_at(workspace, row + j - 1) - row_potential[i] - col_potential[j] == 0) {
+                row_match[i] = j;
+                col_owner[j] = i;
+                break;
             }
         }
     }
-    return 0;
 }
 
-// Helper function to find the minimum uncovered value
-static int find_min_uncovered(const int** cost_matrix, int n,
-                            const int* row_cover, const int* col_cover) {
-    int min = INF;
-    for (int i = 0; i < n; i++) {
-        if (!row_cover[i]) {
-            for (int j = 0; j < n; j++) {
-                if (!col_cover[j] && cost_matrix[i][j] < min) {
-                    min = cost_matrix[i][j];
-                }
-            }
-        }
+static void* aligned_buffer(size_t bytes) {
+    void* buffer = NULL;
+    if (posix_memalign(&buffer, WORKSPACE_ALIGNMENT, bytes ? bytes : WORKSPACE_ALIGNMENT) != 0) {
+        return NULL;
     }
-    return min;
+    return buffer;
+}
+
+void solver_workspace_init(SolverWorkspace* workspace) {
+    memset(workspace, 0, sizeof(*workspace));
 }
 
-// Helper function to cover zeros with minimum lines
-static void cover_zeros(const int** cost_matrix, int n, int* row_assignment, int* col_assignment) {
-    int row_cover[MAX_FREELANCERS] = {0};
-    int col_cover[MAX_PROJECTS] = {0};
+void solver_workspace_free(SolverWorkspace* workspace) {
+    free(workspace->cost);
+    free(workspace->col_min);
+    free(workspace->row_potential);
+    free(workspace->col_potential);
+    free(workspace->col_owner);
+    free(workspace->row_match);
+    free(workspace->path);
+    free(workspace->min_slack);
+    free(workspace->col_used);
+    free(workspace->tree_cols);
+    free(workspace->row_assignment);
+    free(workspace->greedy_edges);
+    free(workspace->graph.row_start);
+    free(workspace->graph.edge_project);
+    free(workspace->graph.edge_weight);
+    candidate_index_free(&workspace->candidates);
+    solver_workspace_init(workspace);
+}
 
-    // Initialize assignments to -1
-    for (int i = 0; i < n; i++) {
-        row_assignment[i] = -1;
-        col_assignment[i] = -1;
+// Bytes held by the solver buffers at the current capacities
+static size_t workspace_bytes(const SolverWorkspace* workspace) {
+    size_t entry_bytes = workspace->wide_capacity == workspace->capacity && workspace->capacity ?
+                         sizeof(wide_cost_t) : sizeof(cost_t);
+    size_t matrix_bytes = (size_t)workspace->capacity * workspace->capacity * entry_bytes;
+    size_t vector_bytes = workspace->vector_capacity ?
+                          (size_t)(workspace->vector_capacity + 1) * sizeof(int) : 0;
+    return matrix_bytes + 9 * vector_bytes + (size_t)workspace->vector_capacity * sizeof(cost_t) +
+           workspace->greedy_capacity * 2 * sizeof(int);
+}
+
+// Grow the per-row and per-column vectors to `capacity` entries
+static int reserve_vectors(SolverWorkspace* workspace, int capacity) {
+    if (capacity <= workspace->vector_capacity) return 1;
+    size_t vector_bytes = (size_t)(capacity + 1) * sizeof(int);
+
+    SolverWorkspace grown = *workspace;
+    grown.col_min = (cost_t*)aligned_buffer(capacity * sizeof(cost_t));
+    grown.row_potential = (int*)aligned_buffer(vector_bytes);
+    grown.col_potential = (int*)aligned_buffer(vector_bytes);
+    grown.col_owner = (int*)aligned_buffer(vector_bytes);
+    grown.row_match = (int*)aligned_buffer(vector_bytes);
+    grown.path = (int*)aligned_buffer(vector_bytes);
+    grown.min_slack = (int*)aligned_buffer(vector_bytes);
+    grown.col_used = (int*)aligned_buffer(vector_bytes);
+    grown.tree_cols = (int*)aligned_buffer(vector_bytes);
+    grown.row_assignment = (int*)aligned_buffer(vector_bytes);
+    if (!grown.col_min || !grown.row_potential || !grown.col_potential ||
+        !grown.col_owner || !grown.row_match || !grown.path || !grown.min_slack ||
+        !grown.col_used || !grown.tree_cols || !grown.row_assignment) {
+        free(grown.col_min);
+        free(grown.row_potential);
+        free(grown.col_potential);
+        free(grown.col_owner);
+        free(grown.row_match);
+        free(grown.path);
+        free(grown.min_slack);
+        free(grown.col_used);
+        free(grown.tree_cols);
+        free(grown.row_assignment);
+        return 0;
     }
 
-    // Find independent zeros
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            if (cost_matrix[i][j] == 0 && !row_cover[i] && !col_cover[j]) {
-                row_assignment[i] = j;
-                col_assignment[j] = i;
-                row_cover[i] = 1;
-                col_cover[j] = 1;
-                break;
-            }
-        }
+    free(workspace->col_min);
+    free(workspace->row_potential);
+    free(workspace->col_potential);
+    free(workspace->col_owner);
+    free(workspace->row_match);
+    free(workspace->path);
+    free(workspace->min_slack);
+    free(workspace->col_used);
+    free(workspace->tree_cols);
+    free(workspace->row_assignment);
+
+    grown.vector_capacity = capacity;
+    grown.bytes = workspace_bytes(&grown);
+    *workspace = grown;
+    metrics_set_gauge(GAUGE_WORKSPACE_BYTES, (int64_t)workspace->bytes);
+    return 1;
+}
+
+int solver_workspace_reserve(SolverWorkspace* workspace, int size) {
+    if (size <= workspace->capacity) return 1;
+
+    // Round up to whole 64-byte rows; this also absorbs small growth steps
+    int capacity = (size + 31) & ~31;
+    if (!reserve_vectors(workspace, capacity)) return 0;
+    cost_t* cost = (cost_t*)aligned_buffer((size_t)capacity * capacity * sizeof(cost_t));
+    if (!cost) return 0;
+    free(workspace->cost);
+    workspace->cost = cost;
+    workspace->capacity = capacity;
+    workspace->bytes = workspace_bytes(workspace);
+    metrics_set_gauge(GAUGE_WORKSPACE_BYTES, (int64_t)workspace->bytes);
+    return 1;
+}
+
+// Make the matrix hold wide_cost_t entries for a size x size problem
+static int reserve_wide(SolverWorkspace* workspace, int size) {
+    if (!solver_workspace_reserve(workspace, size)) return 0;
+    if (workspace->wide_capacity == workspace->capacity) return 1;
+    int capacity = workspace->capacity;
+    cost_t* cost = (cost_t*)aligned_buffer((size_t)capacity * capacity * sizeof(wide_cost_t));
+    if (!cost) return 0;
+    free(workspace->cost);
+    workspace->cost = cost;
+    workspace->wide_capacity = capacity;
+    workspace->bytes = workspace_bytes(workspace);
+    metrics_set_gauge(GAUGE_WORKSPACE_BYTES, (int64_t)workspace->bytes);
+    return 1;
+}
+
+int solver_cost_scale(const uint8_t* row_penalty, int num_rows) {
+    if (!row_penalty) return 1;
+    long scale = 1;
+    for (int i = 0; i < num_rows; i++) {
+        scale += row_penalty[i];
     }
+    return scale > INT_MAX ? INT_MAX : (int)scale;
+}
+
+int solver_workspace_reserve_greedy(SolverWorkspace* workspace, int size) {
+    return reserve_vectors(workspace, (size + 31) & ~31);
 }
 
 // Graph operations
 BipartiteGraph* create_graph(int num_freelancers, int num_projects) {
-    BipartiteGraph* graph = (BipartiteGraph*)malloc(sizeof(BipartiteGraph));
-    graph->num_nodes = num_freelancers + num_projects;
-    graph->adjacency_list = (GraphNode**)calloc(graph->num_nodes, sizeof(GraphNode*));
-    graph->node_types = (int*)calloc(graph->num_nodes, sizeof(int));
-    
-    // Initialize node types
-    for (int i = 0; i < num_freelancers; i++) {
-        graph->node_types[i] = 0;  // Freelancer
-    }
-    for (int i = num_freelancers; i < graph->num_nodes; i++) {
-        graph->node_types[i] = 1;  // Project
-    }
-    
+    BipartiteGraph* graph = (BipartiteGraph*)calloc(1, sizeof(BipartiteGraph));
+    reset_graph(graph, num_freelancers, num_projects);
     return graph;
 }
 
-void add_edge(BipartiteGraph* graph, int freelancer_id, int project_id, int weight) {
-    GraphNode* new_node = (GraphNode*)malloc(sizeof(GraphNode));
-    new_node->id = project_id;
-    new_node->weight = weight;
-    new_node->next = graph->adjacency_list[freelancer_id];
-    graph->adjacency_list[freelancer_id] = new_node;
-    
-    // Add reverse edge for bipartite graph
-    new_node = (GraphNode*)malloc(sizeof(GraphNode));
-    new_node->id = freelancer_id;
-    new_node->weight = weight;
-    new_node->next = graph->adjacency_list[project_id];
-    graph->adjacency_list[project_id] = new_node;
+// Empty the graph, keeping its arrays for reuse
+void reset_graph(BipartiteGraph* graph, int num_freelancers, int num_projects) {
+    if (num_freelancers + 1 > graph->row_capacity) {
+        free(graph->row_start);
+        graph->row_start = (int*)malloc((num_freelancers + 1) * sizeof(int));
+        graph->row_capacity = graph->row_start ? num_freelancers + 1 : 0;
+    }
+    graph->num_freelancers = num_freelancers;
+    graph->num_projects = num_projects;
+    graph->num_edges = 0;
+    graph->last_row = -1;
+}
+
+int add_edge(BipartiteGraph* graph, int freelancer_id, int project_id, int weight) {
+    if (!graph->row_start) return 0;
+    if (graph->num_edges == graph->edge_capacity) {
+        // edge_capacity only moves once both arrays have grown
+        int capacity = graph->edge_capacity ? graph->edge_capacity * 2 : 256;
+        int* projects = (int*)realloc(graph->edge_project, capacity * sizeof(int));
+        if (!projects) return 0;
+        graph->edge_project = projects;
+        int* weights = (int*)realloc(graph->edge_weight, capacity * sizeof(int));
+        if (!weights) return 0;
+        graph->edge_weight = weights;
+        graph->edge_capacity = capacity;
+    }
+
+    // Open the rows up to this freelancer
+    while (graph->last_row < freelancer_id) {
+        graph->row_start[++graph->last_row] = graph->num_edges;
+    }
+
+    graph->edge_project[graph->num_edges] = project_id - graph->num_freelancers;
+    graph->edge_weight[graph->num_edges] = weight;
+    graph->num_edges++;
+    return 1;
 }
 
 void free_graph(BipartiteGraph* graph) {
-    for (int i = 0; i < graph->num_nodes; i++) {
-        GraphNode* current = graph->adjacency_list[i];
-        while (current != NULL) {
-            GraphNode* temp = current;
-            current = current->next;
-            free(temp);
+    free(graph->row_start);
+    free(graph->edge_project);
+    free(graph->edge_weight);
+    free(graph);
+}
+
+// Total score of the rows currently matched to real edges. Row penalties
+// stay below one scale step, so dividing by the scale drops them.
+static long matching_objective(const SolverWorkspace* workspace, const int* row_match,
+                               int num_freelancers, int num_projects) {
+    int scale = workspace->cost_scale;
+    long objective = 0;
+    for (int i = 0; i < num_freelancers; i++) {
+        int j = row_match[i + 1] - 1;
+        if (j >= 0 && j < num_projects) {
+            int cost = cost_at(workspace, (size_t)i * workspace->stride + j);
+            if (cost < NO_EDGE_COST * scale) objective += MAX_SCORE - cost / scale;
         }
     }
-    free(graph->adjacency_list);
-    free(graph->node_types);
-    free(graph);
+    return objective;
 }
 
-// Modified Hungarian Algorithm using graph structure
-void hungarian_algorithm(const BipartiteGraph* graph, int* assignments) {
-    int num_freelancers = 0;
-    for (int i = 0; i < graph->num_nodes; i++) {
-        if (graph->node_types[i] == 0) num_freelancers++;
+// Hungarian Algorithm (shortest augmenting paths with row/column potentials)
+int hungarian_solve(SolverWorkspace* workspace, const BipartiteGraph* graph, int* assignments) {
+    int num_freelancers = graph->num_freelancers;
+    int num_projects = graph->num_projects;
+
+    // The matrix must be square and wide enough for every project column
+    int n = num_freelancers > num_projects ? num_freelancers : num_projects;
+
+    // Initialize assignments
+    for (int i = 0; i < num_freelancers; i++) {
+        assignments[i] = -1;
     }
-    
-    // Create cost matrix from graph
-    int** cost_matrix = (int**)malloc(num_freelancers * sizeof(int*));
-    if (!cost_matrix) {
-        return;  // Handle allocation failure
+    if (n == 0) return 1;
+
+    // With fairness on, one score point must outweigh every penalty together,
+    // so the scale is their sum plus one; past 16 bits the matrix goes wide
+    const uint8_t* row_penalty = workspace->row_penalty;
+    int scale = solver_cost_scale(row_penalty, num_freelancers);
+    if ((long)(NO_EDGE_COST + 1) * scale > INT_MAX / 4) return 0;
+    int wide = (long)(NO_EDGE_COST + 1) * scale > COST_MAX;
+    if (!(wide ? reserve_wide(workspace, n) : solver_workspace_reserve(workspace, n))) return 0;
+    workspace->size = n;
+    int stride = (n + 31) & ~31;
+    workspace->stride = stride;
+    workspace->cost_scale = scale;
+    workspace->wide = wide;
+
+    int* u = workspace->row_potential;
+    int* v = workspace->col_potential;
+    int* col_owner = workspace->col_owner;
+    int* row_match = workspace->row_match;
+    int* path = workspace->path;
+    int* min_slack = workspace->min_slack;
+    int* col_used = workspace->col_used;
+    int* tree_cols = workspace->tree_cols;
+
+    // Fill cost matrix from graph edges (higher score = lower cost), with the
+    // row penalty folded in when fairness is on
+    wide_cost_t* wide_matrix = (wide_cost_t*)workspace->cost;
+    for (int i = 0; i < n; i++) {
+        size_t row = (size_t)i * stride;
+        for (int j = 0; j < n; j++) {
+            if (wide) wide_matrix[row + j] = NO_EDGE_COST * scale;
+            else workspace->cost[row + j] = (cost_t)(NO_EDGE_COST * scale);
+        }
     }
-    
     for (int i = 0; i < num_freelancers; i++) {
-        cost_matrix[i] = (int*)malloc(num_freelancers * sizeof(int));
-        if (!cost_matrix[i]) {
-            // Clean up previously allocated memory
-            for (int j = 0; j < i; j++) {
-                free(cost_matrix[j]);
+        size_t row = (size_t)i * stride;
+        int penalty = row_penalty ? row_penalty[i] : 0;
+        for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+            int cost = solver_edge_cost(graph->edge_weight[e], penalty, scale);
+            if (wide) wide_matrix[row + graph->edge_project[e]] = cost;
+            else workspace->cost[row + graph->edge_project[e]] = (cost_t)cost;
+        }
+    }
+
+    SolveProgress* progress = workspace->progress;
+    solve_progress_set_phase(progress, SOLVE_PHASE_REDUCE);
+    if (solve_cancelled(progress)) return 0;
+
+    u[0] = 0;
+    v[0] = 0;
+    if (workspace->seed_col_potential && workspace->seed_size == n) {
+        // Warm start: reuse the earlier column duals and make every row
+        // feasible against them, u_i = min_j (c_ij - v_j)
+        // Duals from a solve at another cost scale are rescaled to this one
+        int seed_scale = workspace->seed_scale > 0 ? workspace->seed_scale : scale;
+        for (int j = 0; j < n; j++) {
+            v[j + 1] = (int)((long)workspace->seed_col_potential[j] * scale / seed_scale);
+        }
+        for (int i = 0; i < n; i++) {
+            size_t row = (size_t)i * stride;
+            int row_min = INF;
+            for (int j = 0; j < n; j++) {
+                int reduced = cost_at(workspace, row + j) - v[j + 1];
+                if (reduced < row_min) row_min = reduced;
             }
-            free(cost_matrix);
-            return;  // Handle allocation failure
+            u[i + 1] = row_min;
         }
-        for (int j = 0; j < num_freelancers; j++) {
-            cost_matrix[i][j] = INF;  // Initialize with infinity
+    } else {
+        // Step 1: Row minimums become the row potentials
+        for (int i = 0; i < n; i++) {
+            u[i + 1] = find_min_in_row(workspace, i, n);
         }
+
+        // Step 2: Column minimums of what remains become the column potentials
+        find_min_in_cols(workspace, n, u, v);
     }
-    
-    // Fill cost matrix from graph edges
-    for (int i = 0; i < num_freelancers; i++) {
-        GraphNode* current = graph->adjacency_list[i];
-        while (current != NULL) {
-            if (graph->node_types[current->id] == 1) {  // If it's a project
-                // Convert score to cost (higher score = lower cost)
-                cost_matrix[i][current->id - num_freelancers] = 100 - current->weight;
+
+    // Step 3: Match greedily on zeros, then augment the remaining rows
+    for (int k = 0; k <= n; k++) {
+        col_owner[k] = 0;
+        row_match[k] = 0;
+    }
+    cover_zeros(workspace, n, u, v, row_match, col_owner);
+
+    if (progress) {
+        int unmatched_rows = 0;
+        for (int i = 1; i <= n; i++) {
+            unmatched_rows += row_match[i] == 0;
+        }
+        atomic_store(&progress->rows_total, unmatched_rows);
+        atomic_store(&progress->augmentations, 0);
+        atomic_store(&progress->objective,
+                     matching_objective(workspace, row_match, num_freelancers, num_projects));
+        solve_progress_set_phase(progress, SOLVE_PHASE_AUGMENT);
+        if (solve_cancelled(progress)) return 0;
+    }
+
+    for (int i = 1; i <= n; i++) {
+        if (row_match[i]) continue;
+
+        // Grow a shortest-path tree from row i until it reaches a free column
+        col_owner[0] = i;
+        int j0 = 0;
+        int tree_size = 0;
+        for (int j = 0; j <= n; j++) {
+            min_slack[j] = INF;
+            col_used[j] = 0;
+        }
+        do {
+            col_used[j0] = -1;
+            tree_cols[tree_size++] = j0;
+            int i0 = col_owner[j0];
+            size_t row = (size_t)(i0 - 1) * stride;
+            int delta = wide ?
+                cost_update_slack_wide((const wide_cost_t*)workspace->cost + row, u[i0],
+                                       v + 1, min_slack + 1, path + 1, col_used + 1, j0, n) :
+                cost_update_slack(workspace->cost + row, u[i0],
+                                  v + 1, min_slack + 1, path + 1, col_used + 1, j0, n);
+            int j1 = find_min_uncovered(delta, min_slack, col_used, col_owner, n);
+
+            // Shift potentials so the new column becomes tight
+            for (int t = 0; t < tree_size; t++) {
+                u[col_owner[tree_cols[t]]] += delta;
             }
-            current = current->next;
+            cost_shift_potentials(v + 1, min_slack + 1, col_used + 1, delta, n);
+            j0 = j1;
+        } while (col_owner[j0] != 0);
+
+        // Flip the matching along the augmenting path
+        do {
+            int j1 = path[j0];
+            col_owner[j0] = col_owner[j1];
+            row_match[col_owner[j0]] = j0;
+            j0 = j1;
+        } while (j0);
+
+        if (progress) {
+            atomic_store(&progress->objective,
+                         matching_objective(workspace, row_match, num_freelancers, num_projects));
+            atomic_fetch_add(&progress->augmentations, 1);
+            if (solve_cancelled(progress)) return 0;
         }
     }
-    
-    // Initialize assignments
+
+    // Copy assignments (padding columns and non-edges are not real matches)
+    for (int i = 0; i < num_freelancers; i++) {
+        int j = row_match[i + 1] - 1;
+        if (j >= 0 && j < num_projects && cost_at(workspace, (size_t)i * stride + j) < NO_EDGE_COST * scale) {
+            assignments[i] = j;
+        }
+    }
+    return 1;
+}
+
+void hungarian_algorithm(const BipartiteGraph* graph, int* assignments) {
+    hungarian_solve(&shared_workspace, graph, assignments);
+}
+
+int greedy_solve(SolverWorkspace* workspace, const BipartiteGraph* graph, int* assignments,
+                 MatchQuality* quality) {
+    int num_freelancers = graph->num_freelancers;
+    int num_projects = graph->num_projects;
+    int num_edges = graph->num_edges;
+    int n = num_freelancers > num_projects ? num_freelancers : num_projects;
+
     for (int i = 0; i < num_freelancers; i++) {
         assignments[i] = -1;
     }
-    
-    // Step 1: Subtract row minimums
+    quality->objective = 0;
+    quality->upper_bound = 0;
+    if (n == 0) return 1;
+    if (!solver_workspace_reserve_greedy(workspace, n)) return 0;
+    if ((size_t)num_edges > workspace->greedy_capacity) {
+        int* grown = (int*)malloc((size_t)num_edges * 2 * sizeof(int));
+        if (!grown) return 0;
+        free(workspace->greedy_edges);
+        workspace->greedy_edges = grown;
+        workspace->greedy_capacity = num_edges;
+        workspace->bytes = workspace_bytes(workspace);
+        metrics_set_gauge(GAUGE_WORKSPACE_BYTES, (int64_t)workspace->bytes);
+    }
+
+    // Counting sort by score, highest first; also collect the per-row and
+    // per-column maxima for the bound
+    int bucket_start[MAX_SCORE + 2] = {0};
+    int* col_best = workspace->min_slack;
+    int* col_taken = workspace->col_used;
+    for (int j = 0; j < num_projects; j++) {
+        col_best[j] = 0;
+        col_taken[j] = 0;
+    }
+    long row_bound = 0;
     for (int i = 0; i < num_freelancers; i++) {
-        int min = find_min_in_row(cost_matrix[i], num_freelancers);
-        if (min != INF) {
-            for (int j = 0; j < num_freelancers; j++) {
-                if (cost_matrix[i][j] != INF) {
-                    cost_matrix[i][j] -= min;
-                }
-            }
+        int row_best = 0;
+        for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+            int score = graph->edge_weight[e];
+            int j = graph->edge_project[e];
+            bucket_start[MAX_SCORE - score + 1]++;
+            if (score > row_best) row_best = score;
+            if (score > col_best[j]) col_best[j] = score;
         }
+        row_bound += row_best;
     }
-    
-    // Step 2: Subtract column minimums
-    for (int j = 0; j < num_freelancers; j++) {
-        int min = find_min_in_col((const int**)cost_matrix, j, num_freelancers);
-        if (min != INF) {
-            for (int i = 0; i < num_freelancers; i++) {
-                if (cost_matrix[i][j] != INF) {
-                    cost_matrix[i][j] -= min;
-                }
-            }
-        }
+    long col_bound = 0;
+    for (int j = 0; j < num_projects; j++) {
+        col_bound += col_best[j];
     }
-    
-    // Step 3: Cover zeros with minimum lines
-    int row_assignment[MAX_FREELANCERS];
-    int col_assignment[MAX_PROJECTS];
-    cover_zeros((const int**)cost_matrix, num_freelancers, row_assignment, col_assignment);
-    
-    // Copy assignments
+    for (int b = 1; b <= MAX_SCORE + 1; b++) {
+        bucket_start[b] += bucket_start[b - 1];
+    }
+    int* ordered = workspace->greedy_edges;
     for (int i = 0; i < num_freelancers; i++) {
-        assignments[i] = row_assignment[i];
+        for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+            int slot = bucket_start[MAX_SCORE - graph->edge_weight[e]]++;
+            ordered[2 * slot] = i;
+            ordered[2 * slot + 1] = graph->edge_project[e];
+        }
     }
-    
-    // Free cost matrix
+
+    // Take each edge whose freelancer and project are both still free
+    int remaining = num_freelancers < num_projects ? num_freelancers : num_projects;
+    for (int k = 0; k < num_edges && remaining > 0; k++) {
+        int i = ordered[2 * k];
+        int j = ordered[2 * k + 1];
+        if (assignments[i] == -1 && !col_taken[j]) {
+            assignments[i] = j;
+            col_taken[j] = 1;
+            remaining--;
+        }
+    }
+
     for (int i = 0; i < num_freelancers; i++) {
-        free(cost_matrix[i]);
+        if (assignments[i] == -1) continue;
+        for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+            if (graph->edge_project[e] == assignments[i]) {
+                quality->objective += graph->edge_weight[e];
+                break;
+            }
+        }
     }
-    free(cost_matrix);
+    // Each row (column) contributes at most its best edge; and taking edges
+    // best first is a 1/2-approximation, so the optimum is also <= 2x greedy
+    quality->upper_bound = row_bound < col_bound ? row_bound : col_bound;
+    if (2 * quality->objective < quality->upper_bound) {
+        quality->upper_bound = 2 * quality->objective;
+    }
+
+    return 1;
 }
 
-// Modified matching function to use graph structure
-void match_freelancers_to_projects(const Freelancer* freelancers, int num_freelancers,
-                                 const Project* projects, int num_projects,
-                                 Assignment* assignments) {
-    // Create bipartite graph
-    BipartiteGraph* graph = create_graph(num_freelancers, num_projects);
+// Score of the edge between freelancer i and project j, 0 if there is none
+static int edge_score(const BipartiteGraph* graph, int i, int j) {
+    for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+        if (graph->edge_project[e] == j) return graph->edge_weight[e];
+    }
+    return 0;
+}
+
+int build_compatibility_graph(SolverWorkspace* workspace,
+                               const Freelancer* freelancers, int num_freelancers,
+                               const Project* projects, int num_projects) {
+    // Reuse the workspace's bipartite graph
+    BipartiteGraph* graph = &workspace->graph;
+    reset_graph(graph, num_freelancers, num_projects);
     
-    // Add edges based on compatibility
-    for (int i = 0; i < num_freelancers; i++) {
-        for (int j = 0; j < num_projects; j++) {
+    // Add edges based on compatibility (the longest phase, so cancellable per row).
+    // Only projects sharing a skill (or a similar one) with the freelancer can
+    // score above zero, so the index hands over just those. If the index
+    // cannot be built, every pair is scored.
+    CandidateIndex* index = &workspace->candidates;
+    int indexed = candidate_index_build(index, projects, num_projects);
+    for (int i = 0; i < num_freelancers && !solve_cancelled(workspace->progress); i++) {
+        int count = indexed ? candidate_index_query(index, &freelancers[i], i) : num_projects;
+        for (int c = 0; c < count; c++) {
+            int j = indexed ? index->candidates[c] : c;
             int compatibility_score = calculate_compatibility(&freelancers[i], &projects[j]);
-            if (compatibility_score > 0) {
-                add_edge(graph, i, j + num_freelancers, compatibility_score);
+            if (compatibility_score > 0 &&
+                !add_edge(graph, i, j + num_freelancers, compatibility_score)) {
+                return 0;
             }
         }
     }
+    return 1;
+}
+
+int match_with_mode(SolverWorkspace* workspace, SolverMode mode,
+                    const Freelancer* freelancers, int num_freelancers,
+                    const Project* projects, int num_projects,
+                    Assignment* assignments, MatchQuality* quality) {
+    uint64_t stage_start = metrics_now_ns();
+    solve_progress_set_phase(workspace->progress, SOLVE_PHASE_BUILD_GRAPH);
+    BipartiteGraph* graph = &workspace->graph;
+    int built = build_compatibility_graph(workspace, freelancers, num_freelancers, projects, num_projects);
+    metrics_observe_stage(STAGE_BUILD_GRAPH, metrics_now_ns() - stage_start);
+    metrics_set_gauge(GAUGE_EDGES, graph->num_edges);
     
-    // Perform matching using Hungarian Algorithm
-    int* temp_assignments = (int*)calloc(num_freelancers, sizeof(int));
-    hungarian_algorithm(graph, temp_assignments);
+    // Perform matching using the Hungarian Algorithm or the greedy fast path
+    stage_start = metrics_now_ns();
+    int n = num_freelancers > num_projects ? num_freelancers : num_projects;
+    MatchQuality greedy_quality = { 0, 0 };
+    int* row_assignment = NULL;
+    int sharded = 0;
+    if (built && mode == SOLVER_EXACT && shard_pool_size() > 0 && n > shard_max_nodes() &&
+        !solve_cancelled(workspace->progress)) {
+        // Too big for one dense matrix here: hand the components to the worker
+        // processes, and only fall back to the in-process solver if that fails
+        row_assignment = (int*)malloc((num_freelancers + 1) * sizeof(int));
+        ShardStats shard_stats;
+        sharded = row_assignment && sharded_solve(graph, workspace->row_penalty, row_assignment, &shard_stats);
+        if (sharded) {
+            metrics_observe_stage(STAGE_SHARDED, metrics_now_ns() - stage_start);
+            // No duals come back from the workers
+            workspace->size = 0;
+        } else {
+            free(row_assignment);
+            row_assignment = NULL;
+        }
+    }
+    // Greedy never reads the cost matrix, so it only needs the O(n) vectors
+    int solved = sharded || (built && !solve_cancelled(workspace->progress) &&
+                             (mode == SOLVER_GREEDY ? solver_workspace_reserve_greedy(workspace, n) :
+                                                      solver_workspace_reserve(workspace, n)));
+    if (sharded) {
+        // Already solved
+    } else if (mode == SOLVER_GREEDY) {
+        solved = solved && greedy_solve(workspace, graph, workspace->row_assignment, &greedy_quality);
+        metrics_observe_stage(STAGE_GREEDY, metrics_now_ns() - stage_start);
+    } else {
+        solved = solved && hungarian_solve(workspace, graph, workspace->row_assignment);
+        metrics_observe_stage(STAGE_HUNGARIAN, metrics_now_ns() - stage_start);
+    }
+    if (!sharded) row_assignment = workspace->row_assignment;
     
     // Convert assignments to the required format
     int assignment_count = 0;
-    for (int i = 0; i < num_freelancers; i++) {
-        if (temp_assignments[i] != -1) {
+    long objective = 0;
+    for (int i = 0; solved && i < num_freelancers; i++) {
+        int j = row_assignment[i];
+        if (j != -1) {
+            int score = mode == SOLVER_GREEDY || sharded ? edge_score(graph, i, j) :
+                        MAX_SCORE - cost_at(workspace, (size_t)i * workspace->stride + j) / workspace->cost_scale;
             assignments[assignment_count].freelancer_id = freelancers[i].id;
-            assignments[assignment_count].project_id = projects[temp_assignments[i]].id;
-            
-            // Find the edge weight for this assignment
-            GraphNode* current = graph->adjacency_list[i];
-            while (current != NULL) {
-                if (current->id == temp_assignments[i] + num_freelancers) {
-                    assignments[assignment_count].score = current->weight;
-                    break;
-                }
-                current = current->next;
-            }
-            
+            assignments[assignment_count].project_id = projects[j].id;
+            assignments[assignment_count].score = score;
+            objective += score;
             assignment_count++;
         }
     }
     
-    free(temp_assignments);
-    free_graph(graph);
+    // Mark the unused slots so callers can scan all num_freelancers entries
+    for (int i = assignment_count; i < num_freelancers; i++) {
+        assignments[i].freelancer_id = -1;
+        assignments[i].project_id = -1;
+        assignments[i].score = 0;
+    }
+    metrics_set_gauge(GAUGE_ASSIGNMENTS, assignment_count);
+    if (sharded) free(row_assignment);
+    
+    if (quality) {
+        quality->objective = objective;
+        quality->upper_bound = mode == SOLVER_GREEDY ? greedy_quality.upper_bound : objective;
+    }
+    return assignment_count;
+}
+
+int match_with_workspace(SolverWorkspace* workspace,
+                         const Freelancer* freelancers, int num_freelancers,
+                         const Project* projects, int num_projects,
+                         Assignment* assignments) {
+    return match_with_mode(workspace, SOLVER_EXACT, freelancers, num_freelancers,
+                           projects, num_projects, assignments, NULL);
+}
+
+// Matching on the process-wide workspace
+int match_freelancers_to_projects(const Freelancer* freelancers, int num_freelancers,
+                                 const Project* projects, int num_projects,
+                                 Assignment* assignments) {
+    return match_with_workspace(&shared_workspace, freelancers, num_freelancers,
+                                projects, num_projects, assignments);
+}
+
+// Experience floor as a percentage of min_experience, 0 when off
+static int experience_floor_percent;
+
+void set_min_experience_percent(int percent) {
+    experience_floor_percent = percent > 0 ? percent : 0;
+}
+
+int min_experience_percent(void) {
+    return experience_floor_percent;
 }
 
 // Helper function to calculate compatibility score
 int calculate_compatibility(const Freelancer* freelancer, const Project* project) {
-    int matched_skills = 0;
+    if (experience_floor_percent > 0 &&
+        freelancer->experience * 100 < experience_floor_percent * project->min_experience) {
+        return 0;
+    }
+    int skill_credit = 0;
     int experience_match = 0;
     
-    // Calculate skill match percentage
+    // Calculate skill match percentage: full credit for the same interned
+    // skill, otherwise the best partial credit from the similarity table
+    int use_similarity = skill_similarity.size > 0;
     for (int i = 0; i < project->num_required_skills; i++) {
+        SkillId required = project->required_skill_ids[i];
+        if (required == SKILL_ID_NONE) continue;
+        int best = 0;
         for (int j = 0; j < freelancer->num_skills; j++) {
-            if (strcmp(project->required_skills[i], freelancer->skills[j]) == 0) {
-                matched_skills++;
+            if (freelancer->skill_ids[j] == required) {
+                best = SKILL_FULL_CREDIT;
                 break;
             }
+            if (use_similarity) {
+                int credit = skill_similarity_credit(required, freelancer->skill_ids[j]);
+                if (credit > best) best = credit;
+            }
         }
+        skill_credit += best;
     }
     
     // Convert matched skills to percentage
     int skill_match = project->num_required_skills > 0 ?
-        (matched_skills * 100) / project->num_required_skills : 0;
+        skill_credit / project->num_required_skills : 0;
     
     // Calculate experience match percentage
     if (freelancer->experience >= project->min_experience) {
@@ -296,6 +740,6 @@ int calculate_compatibility(const Freelancer* freelancer, const Project* project
     // Weighted combination (70% skills, 30% experience)
     int total_score = (skill_match * 70 + experience_match * 30) / 100;
     
-    // Only return score if there's at least one skill match
-    return matched_skills > 0 ? total_score : 0;
+    // Only return score if there's at least one (partial) skill match
+    return skill_credit > 0 ? total_score : 0;
 } 
\ No newline at end of file
@@ -2,5 +2,156 @@
 #define MATCH_ALLOCATOR_H
 
 #include "utils.h"
+#include "cost_kernels.h"
+#include "candidates.h"
+#include <stdatomic.h>
 
-#endif /* MATCH_ALLOCATOR_H */ 
\ No newline at end of file
+// Where a watched solve currently is
+typedef enum {
+    SOLVE_PHASE_QUEUED,
+    SOLVE_PHASE_LOAD,
+    SOLVE_PHASE_BUILD_GRAPH,
+    SOLVE_PHASE_REDUCE,
+    SOLVE_PHASE_AUGMENT,
+    SOLVE_PHASE_FORMAT,
+    SOLVE_PHASE_DONE
+} SolvePhase;
+
+// Progress of a solve running on another thread. The solver publishes into
+// it and checks cancel_requested between phases and after every augmentation.
+typedef struct {
+    atomic_int phase;             // SolvePhase
+    atomic_int cancel_requested;
+    atomic_int rows_total;        // rows left to place when augmentation starts
+    atomic_int augmentations;     // augmenting paths found so far
+    atomic_long objective;        // total score of the current partial matching
+} SolveProgress;
+
+static inline void solve_progress_set_phase(SolveProgress* progress, SolvePhase phase) {
+    if (progress) atomic_store_explicit(&progress->phase, phase, memory_order_relaxed);
+}
+
+static inline int solve_cancelled(const SolveProgress* progress) {
+    return progress && atomic_load_explicit(&progress->cancel_requested, memory_order_relaxed);
+}
+
+// Optional per-row penalties are below ROW_PENALTY_SCALE, read as fractions of
+// a score point when reported. The solver itself weighs them with
+// solver_cost_scale(), so together they never outweigh a point of score.
+#define ROW_PENALTY_SCALE 64
+#define MAX_SCORE 100
+
+// Cost the exact solver gives an edge scoring `score` on a row with `penalty`,
+// at `scale` cost units per score point. A missing edge costs the same as
+// solver_edge_cost(0, 0, scale).
+static inline int solver_edge_cost(int score, int penalty, int scale) {
+    return (MAX_SCORE - score) * scale + penalty;
+}
+
+// Cost units per score point for a solve with these row penalties (NULL for
+// none): one more than their sum, so no set of penalties can pay for a lost
+// point and fairness only breaks ties between maximum-score matchings
+int solver_cost_scale(const uint8_t* row_penalty, int num_rows);
+
+// Scratch buffers for the Hungarian solver. A workspace is reused across
+// solves and only grows when a larger problem arrives, so steady-state
+// requests do not allocate.
+typedef struct {
+    int capacity;             // largest square matrix the buffers can hold
+    int vector_capacity;      // entries the per-row/column vectors can hold (>= capacity)
+    int size;                 // dimension of the last solve
+    int stride;               // row pitch of cost in elements (64-byte multiple)
+    cost_t* cost;             // size rows of stride costs, 64-byte aligned; wide_cost_t
+                              // entries when wide is set
+    int wide;                 // the last solve's scale needed 32-bit costs
+    int wide_capacity;        // capacity at which cost was sized for wide_cost_t
+    cost_t* col_min;          // column-reduction accumulator
+    int* row_potential;       // u, indexed 1..size (0 is the virtual row)
+    int* col_potential;       // v, indexed 1..size
+    int* col_owner;           // row matched to each column, 0 when free
+    int* row_match;           // column matched to each row, 0 when free
+    int* path;                // previous column on the augmenting path
+    int* min_slack;           // smallest reduced cost reaching each column
+    int* col_used;            // -1 for columns covered by the current search, else 0
+    int* tree_cols;           // covered columns, in the order they were added
+    int* row_assignment;      // solver result per freelancer
+    int* greedy_edges;        // (row, column) pairs in score order for greedy_solve
+    size_t greedy_capacity;   // edges greedy_edges can hold
+    BipartiteGraph graph;     // edge storage reused by match_with_workspace
+    CandidateIndex candidates;  // skill posting lists for building graph
+    SolveProgress* progress;  // optional progress/cancellation, NULL when unwatched
+    const int* seed_col_potential;  // optional warm start: column duals of an earlier
+    int seed_size;                  // solve of the same size, 0-based (caller owns)
+    int seed_scale;                 // cost units per score point behind the seed, 0 if
+                                    // the same as this solve's
+    const uint8_t* row_penalty;     // optional per-freelancer cost added to every edge of
+                                    // the row, below ROW_PENALTY_SCALE (caller owns)
+    int cost_scale;           // cost units per score point in the last solve
+    size_t bytes;             // bytes currently held by the buffers above
+} SolverWorkspace;
+
+void solver_workspace_init(SolverWorkspace* workspace);
+// Make room for a size x size problem; returns 0 on allocation failure
+int solver_workspace_reserve(SolverWorkspace* workspace, int size);
+// Make room for greedy_solve() on `size` rows/columns: the vectors only, no
+// cost matrix; returns 0 on allocation failure
+int solver_workspace_reserve_greedy(SolverWorkspace* workspace, int size);
+void solver_workspace_free(SolverWorkspace* workspace);
+
+// Solve the assignment problem on a freelancer/project graph.
+// assignments[i] receives the project index for freelancer i, or -1.
+// Returns 0 if the workspace could not be grown or the solve was cancelled.
+// With seed_col_potential set for a problem of the same size the solve starts
+// from those duals, so an unchanged or slightly changed problem needs few
+// augmentations. With row_penalty set, costs are scaled by solver_cost_scale()
+// and each edge of row i also costs row_penalty[i]: the total score still
+// comes first, and among matchings that score the same the less-penalised
+// one wins. Leaving a freelancer unassigned costs no penalty.
+int hungarian_solve(SolverWorkspace* workspace, const BipartiteGraph* graph, int* assignments);
+
+// Same, using the process-wide workspace
+void hungarian_algorithm(const BipartiteGraph* graph, int* assignments);
+
+// Which solver match_with_mode() runs
+typedef enum {
+    SOLVER_EXACT,             // Hungarian algorithm, optimal total score
+    SOLVER_GREEDY             // highest-score-first greedy, approximate
+} SolverMode;
+
+// Total score of a matching and an upper bound on the optimum
+typedef struct {
+    long objective;
+    long upper_bound;
+} MatchQuality;
+
+// Greedy matching: edges are counting-sorted by score (0..100) and taken
+// best first whenever both sides are still free. assignments[i] receives the
+// project index for freelancer i, or -1. The upper bound is the smallest of
+// the sums of row maxima and column maxima and twice the greedy objective.
+// Returns 0 on allocation failure.
+int greedy_solve(SolverWorkspace* workspace, const BipartiteGraph* graph, int* assignments,
+                 MatchQuality* quality);
+
+// Fill workspace->graph with every freelancer/project pair that scores above
+// zero. Candidates come from the workspace's skill index, so the cost follows
+// the number of feasible pairs rather than F x P. Returns 0 if the graph could
+// not hold every edge.
+int build_compatibility_graph(SolverWorkspace* workspace,
+                               const Freelancer* freelancers, int num_freelancers,
+                               const Project* projects, int num_projects);
+
+// match_with_workspace() with a choice of solver; `quality` may be NULL.
+// For SOLVER_EXACT the upper bound equals the objective.
+int match_with_mode(SolverWorkspace* workspace, SolverMode mode,
+                    const Freelancer* freelancers, int num_freelancers,
+                    const Project* projects, int num_projects,
+                    Assignment* assignments, MatchQuality* quality);
+
+// match_freelancers_to_projects() on an explicit workspace. A cancelled
+// solve returns no assignments.
+int match_with_workspace(SolverWorkspace* workspace,
+                         const Freelancer* freelancers, int num_freelancers,
+                         const Project* projects, int num_projects,
+                         Assignment* assignments);
+
+#endif /* MATCH_ALLOCATOR_H */ 
@@ -0,0 +1,877 @@
+#include "match_results.h"
+#include "metrics.h"
+#include "match_allocator.h"
+#include "skills.h"
+#include "fairness.h"
+#include <sys/stat.h>
+#include <zlib.h>
+
+#define SCORE_BUCKETS 11  // 0-9, 10-19, ..., 90-99, 100
+
+static MatchResult current;
+static int current_loaded;
+static SolverWorkspace results_workspace;   // solves run on the main thread
+static SolverWorkspace greedy_workspace;    // fast-path solves, also main thread
+static int* snapshot_seed;                  // column duals from a stale snapshot
+static int snapshot_seed_size;
+static int snapshot_seed_scale;
+
+// FNV-1a over the stat fields that change when a file is rewritten
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t length) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t dataset_version(void) {
+    const char* files[] = { FREELANCERS_CSV, PROJECTS_CSV, AVAILABILITY_CSV };
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t f = 0; f < sizeof(files) / sizeof(files[0]); f++) {
+        struct stat st;
+        if (stat(files[f], &st) != 0) {
+            memset(&st, 0, sizeof(st));
+        }
+        hash = hash_bytes(hash, &st.st_size, sizeof(st.st_size));
+        hash = hash_bytes(hash, &st.st_mtim, sizeof(st.st_mtim));
+        hash = hash_bytes(hash, &st.st_ino, sizeof(st.st_ino));
+    }
+    return hash;
+}
+
+void match_results_free(MatchResult* result) {
+    free(result->freelancers);
+    free(result->projects);
+    free(result->assignments);
+    free(result->freelancer_project);
+    free(result->freelancer_score);
+    free(result->unmatched_projects);
+    free(result->project_freelancer);
+    free(result->freelancer_ids);
+    free(result->project_ids);
+    free(result->full_json);
+    free(result->summary_json);
+    free(result->row_potential);
+    free(result->col_potential);
+    free(result->row_penalty);
+    for (int e = 0; e < ENCODING_COUNT; e++) {
+        free(result->full_json_compressed[e].data);
+        free(result->summary_json_compressed[e].data);
+    }
+}
+
+typedef struct {
+    const char* name;
+    int count;
+} SkillCount;
+
+static int compare_strings(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+static int compare_skill_counts(const void* a, const void* b) {
+    const SkillCount* x = (const SkillCount*)a;
+    const SkillCount* y = (const SkillCount*)b;
+    if (x->count != y->count) return y->count - x->count;
+    return strcmp(x->name, y->name);
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Aggregates behind the frontend's statistics panel and charts
+static char* build_summary_json(const MatchResult* result) {
+    int num_freelancers = result->num_freelancers;
+    int histogram[SCORE_BUCKETS] = {0};
+    int excellent = 0, good = 0, fair = 0, poor = 0;
+    long total_score = 0;
+    int min_score = 0, max_score = 0;
+
+    for (int a = 0; a < result->num_assignments; a++) {
+        int score = result->assignments[a].score;
+        histogram[score / 10 < SCORE_BUCKETS ? score / 10 : SCORE_BUCKETS - 1]++;
+        if (score >= 80) excellent++;
+        else if (score >= 60) good++;
+        else if (score >= 40) fair++;
+        else poor++;
+        total_score += score;
+        if (a == 0 || score < min_score) min_score = score;
+        if (a == 0 || score > max_score) max_score = score;
+    }
+
+    StringBuffer json;
+    strbuf_init(&json, 4096);
+    int assigned = result->num_assignments;
+    strbuf_appendf(&json,
+                   "{\"total_freelancers\":%d,\"total_projects\":%d,"
+                   "\"statistics\":{\"assigned_count\":%d,\"assigned_percentage\":%.1f,"
+                   "\"unassigned_count\":%d,\"unassigned_percentage\":%.1f,"
+                   "\"unmatched_projects\":%d,\"strong_matches\":%d,\"total_score\":%ld,"
+                   "\"average_score\":%.1f,\"min_score\":%d,\"max_score\":%d},",
+                   num_freelancers, result->num_projects,
+                   assigned, num_freelancers ? (float)assigned / num_freelancers * 100 : 0.0f,
+                   num_freelancers - assigned,
+                   num_freelancers ? (float)(num_freelancers - assigned) / num_freelancers * 100 : 0.0f,
+                   result->num_unmatched_projects, excellent + good, total_score,
+                   assigned ? (double)total_score / assigned : 0.0, min_score, max_score);
+    strbuf_appendf(&json, "\"quality\":{\"excellent\":%d,\"good\":%d,\"fair\":%d,\"poor\":%d},",
+                   excellent, good, fair, poor);
+
+    strbuf_appendf(&json, "\"score_histogram\":[");
+    for (int b = 0; b < SCORE_BUCKETS; b++) {
+        strbuf_appendf(&json, "%s%d", b > 0 ? "," : "", histogram[b]);
+    }
+
+    // Skill frequencies: sort every skill name, count the runs, order by count
+    int total_skills = 0;
+    for (int i = 0; i < num_freelancers; i++) {
+        total_skills += result->freelancers[i].num_skills;
+    }
+    const char** names = (const char**)malloc((total_skills + 1) * sizeof(char*));
+    SkillCount* counts = (SkillCount*)malloc((total_skills + 1) * sizeof(SkillCount));
+    int k = 0;
+    for (int i = 0; i < num_freelancers; i++) {
+        for (int s = 0; s < result->freelancers[i].num_skills; s++) {
+            names[k++] = result->freelancers[i].skills[s];
+        }
+    }
+    qsort(names, total_skills, sizeof(char*), compare_strings);
+    int num_counts = 0;
+    for (int s = 0; s < total_skills; s++) {
+        if (num_counts > 0 && strcmp(counts[num_counts - 1].name, names[s]) == 0) {
+            counts[num_counts - 1].count++;
+        } else {
+            counts[num_counts].name = names[s];
+            counts[num_counts].count = 1;
+            num_counts++;
+        }
+    }
+    qsort(counts, num_counts, sizeof(SkillCount), compare_skill_counts);
+    strbuf_appendf(&json, "],\"skill_counts\":[");
+    for (int s = 0; s < num_counts; s++) {
+        strbuf_appendf(&json, "%s{\"skill\":\"%s\",\"count\":%d}", s > 0 ? "," : "",
+                       counts[s].name, counts[s].count);
+    }
+    free(names);
+    free(counts);
+
+    // Experience distribution in ascending years
+    int* years = (int*)malloc((num_freelancers + 1) * sizeof(int));
+    for (int i = 0; i < num_freelancers; i++) {
+        years[i] = result->freelancers[i].experience;
+    }
+    qsort(years, num_freelancers, sizeof(int), compare_ints);
+    strbuf_appendf(&json, "],\"experience_counts\":[");
+    for (int i = 0; i < num_freelancers;) {
+        int run = i;
+        while (run < num_freelancers && years[run] == years[i]) run++;
+        strbuf_appendf(&json, "%s{\"experience\":%d,\"count\":%d}", i > 0 ? "," : "",
+                       years[i], run - i);
+        i = run;
+    }
+    strbuf_appendf(&json, "]}");
+    free(years);
+
+    return strbuf_detach(&json);
+}
+
+// CRC-32 of a whole file; 0 if it cannot be read
+static uint32_t file_checksum(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+    unsigned char chunk[65536];
+    uLong crc = crc32(0L, Z_NULL, 0);
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        crc = crc32(crc, chunk, (uInt)got);
+    }
+    fclose(file);
+    return (uint32_t)crc;
+}
+
+// Ties on id keep file order, so a duplicated id resolves to its first row
+static int compare_id_index(const void* a, const void* b) {
+    const IdIndex* x = (const IdIndex*)a;
+    const IdIndex* y = (const IdIndex*)b;
+    if (x->id != y->id) return (x->id > y->id) - (x->id < y->id);
+    return x->index - y->index;
+}
+
+int match_results_find_id(const IdIndex* table, int count, int id) {
+    int low = 0, high = count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (table[mid].id < id) low = mid + 1;
+        else high = mid;
+    }
+    return low < count && table[low].id == id ? table[low].index : -1;
+}
+
+// Id lookups for index_assignments(), /explain and the wire string table
+static void index_ids(MatchResult* result) {
+    for (int i = 0; i < result->num_freelancers; i++) {
+        result->freelancer_ids[i].id = result->freelancers[i].id;
+        result->freelancer_ids[i].index = i;
+    }
+    qsort(result->freelancer_ids, result->num_freelancers, sizeof(IdIndex), compare_id_index);
+    for (int j = 0; j < result->num_projects; j++) {
+        result->project_ids[j].id = result->projects[j].id;
+        result->project_ids[j].index = j;
+    }
+    qsort(result->project_ids, result->num_projects, sizeof(IdIndex), compare_id_index);
+}
+
+// Read the CSV files and allocate the per-result arrays
+static int load_dataset(MatchResult* result, uint64_t version) {
+    memset(result, 0, sizeof(*result));
+    result->version = version;
+
+    // Size the arrays from the files instead of the fixed MAX_* limits
+    uint64_t stage_start = metrics_now_ns();
+    const char* files[DATASET_FILES] = { FREELANCERS_CSV, PROJECTS_CSV, AVAILABILITY_CSV };
+    for (int f = 0; f < DATASET_FILES; f++) {
+        result->checksums[f] = file_checksum(files[f]);
+    }
+    int freelancer_rows = count_csv_rows(FREELANCERS_CSV);
+    int project_rows = count_csv_rows(PROJECTS_CSV);
+    result->freelancers = (Freelancer*)calloc(freelancer_rows + 1, sizeof(Freelancer));
+    result->projects = (Project*)calloc(project_rows + 1, sizeof(Project));
+    if (!result->freelancers || !result->projects) {
+        match_results_free(result);
+        return 0;
+    }
+    read_freelancers_limit(FREELANCERS_CSV, result->freelancers, freelancer_rows, &result->num_freelancers);
+    read_projects_limit(PROJECTS_CSV, result->projects, project_rows, &result->num_projects);
+    read_availability(AVAILABILITY_CSV, result->freelancers, result->num_freelancers);
+    metrics_observe_stage(STAGE_LOAD_CSV, metrics_now_ns() - stage_start);
+    metrics_set_gauge(GAUGE_FREELANCERS, result->num_freelancers);
+    metrics_set_gauge(GAUGE_PROJECTS, result->num_projects);
+
+    int num_freelancers = result->num_freelancers;
+    int num_projects = result->num_projects;
+    int n = num_freelancers > num_projects ? num_freelancers : num_projects;
+    result->num_potentials = n;
+    result->cost_scale = 1;
+    result->assignments = (Assignment*)calloc(num_freelancers + 1, sizeof(Assignment));
+    result->freelancer_project = (int*)malloc((num_freelancers + 1) * sizeof(int));
+    result->freelancer_score = (int*)calloc(num_freelancers + 1, sizeof(int));
+    result->unmatched_projects = (int*)malloc((num_projects + 1) * sizeof(int));
+    result->project_freelancer = (int*)malloc((num_projects + 1) * sizeof(int));
+    result->freelancer_ids = (IdIndex*)malloc((num_freelancers + 1) * sizeof(IdIndex));
+    result->project_ids = (IdIndex*)malloc((num_projects + 1) * sizeof(IdIndex));
+    result->row_potential = (int*)calloc(n + 1, sizeof(int));
+    result->col_potential = (int*)calloc(n + 1, sizeof(int));
+    if (!result->assignments || !result->freelancer_project || !result->freelancer_score ||
+        !result->unmatched_projects || !result->project_freelancer || !result->freelancer_ids ||
+        !result->project_ids || !result->row_potential || !result->col_potential) {
+        match_results_free(result);
+        return 0;
+    }
+    index_ids(result);
+    return 1;
+}
+
+// Index the assignment list so pages can be written without searching.
+// Assignments come out in freelancer order.
+static void index_assignments(MatchResult* result) {
+    int num_freelancers = result->num_freelancers;
+    int num_projects = result->num_projects;
+    for (int i = 0; i < num_freelancers; i++) {
+        result->freelancer_project[i] = -1;
+        result->freelancer_score[i] = 0;
+    }
+    for (int a = 0, i = 0; a < result->num_assignments; a++) {
+        while (i < num_freelancers && result->freelancers[i].id != result->assignments[a].freelancer_id) i++;
+        if (i == num_freelancers) break;
+        int j = match_results_find_id(result->project_ids, num_projects, result->assignments[a].project_id);
+        if (j < 0) continue;
+        result->freelancer_project[i] = j;
+        result->freelancer_score[i] = result->assignments[a].score;
+    }
+}
+
+// Project-side indexes from freelancer_project: the owner of each project
+// and the list of projects nobody took
+static void index_projects(MatchResult* result) {
+    int num_freelancers = result->num_freelancers;
+    int num_projects = result->num_projects;
+    for (int j = 0; j < num_projects; j++) {
+        result->project_freelancer[j] = -1;
+    }
+    for (int i = 0; i < num_freelancers; i++) {
+        if (result->freelancer_project[i] >= 0) {
+            result->project_freelancer[result->freelancer_project[i]] = i;
+        }
+    }
+    result->num_unmatched_projects = 0;
+    for (int j = 0; j < num_projects; j++) {
+        if (result->project_freelancer[j] < 0) {
+            result->unmatched_projects[result->num_unmatched_projects++] = j;
+        }
+    }
+}
+
+// Everything derived from freelancer_project/freelancer_score: the
+// project indexes and the cached response bodies
+static int finish_result(MatchResult* result) {
+    index_projects(result);
+
+    uint64_t stage_start = metrics_now_ns();
+    result->full_json = format_matches_full_json(result);
+    result->full_json_length = strlen(result->full_json);
+    result->summary_json = build_summary_json(result);
+    result->summary_json_length = strlen(result->summary_json);
+    metrics_observe_stage(STAGE_FORMAT_JSON, metrics_now_ns() - stage_start);
+
+    // Compress the cached bodies now so requests only pay for the copy. Small
+    // bodies stay uncompressed, as on the per-request path; an empty
+    // CompressedBody is served as identity.
+    stage_start = metrics_now_ns();
+    for (int e = ENCODING_GZIP; e < ENCODING_COUNT; e++) {
+        if (result->full_json_length >= COMPRESS_MIN_BYTES) {
+            compress_body(result->full_json, result->full_json_length, (ContentEncoding)e,
+                          CACHED_COMPRESSION_LEVEL, &result->full_json_compressed[e]);
+        }
+        if (result->summary_json_length >= COMPRESS_MIN_BYTES) {
+            compress_body(result->summary_json, result->summary_json_length, (ContentEncoding)e,
+                          CACHED_COMPRESSION_LEVEL, &result->summary_json_compressed[e]);
+        }
+    }
+    metrics_observe_stage(STAGE_COMPRESS, metrics_now_ns() - stage_start);
+    return 1;
+}
+
+int match_results_build(MatchResult* result, uint64_t version, SolverWorkspace* workspace) {
+    if (!workspace) workspace = &results_workspace;
+    SolveProgress* progress = workspace->progress;
+    solve_progress_set_phase(progress, SOLVE_PHASE_LOAD);
+    if (!load_dataset(result, version)) return 0;
+
+    // Fairness goes into the cost matrix of this one solve
+    if (fairness_weight() > 0) {
+        result->row_penalty = (uint8_t*)malloc(result->num_freelancers + 1);
+        if (!result->row_penalty) {
+            match_results_free(result);
+            return 0;
+        }
+        fairness_penalties(result->freelancers, result->num_freelancers, result->row_penalty);
+    }
+    result->cost_scale = solver_cost_scale(result->row_penalty, result->num_freelancers);
+    workspace->row_penalty = result->row_penalty;
+    result->num_assignments = match_with_workspace(workspace, result->freelancers, result->num_freelancers,
+                                                   result->projects, result->num_projects,
+                                                   result->assignments);
+    workspace->row_penalty = NULL;
+    if (solve_cancelled(progress)) {
+        match_results_free(result);
+        return 0;
+    }
+
+    // Keep the final duals for the snapshot (1-based in the workspace)
+    int n = result->num_potentials;
+    if (n > 0 && workspace->size == n) {
+        memcpy(result->row_potential, workspace->row_potential + 1, n * sizeof(int));
+        memcpy(result->col_potential, workspace->col_potential + 1, n * sizeof(int));
+        result->has_potentials = 1;
+    }
+
+    solve_progress_set_phase(progress, SOLVE_PHASE_FORMAT);
+    index_assignments(result);
+    if (!finish_result(result)) return 0;
+    solve_progress_set_phase(progress, SOLVE_PHASE_DONE);
+    return 1;
+}
+
+// Snapshot file layout (host byte order):
+//   SnapshotHeader
+//   int32 project index per freelancer (-1 if unassigned)
+//   int32 score per freelancer
+//   int32 row potentials, then column potentials (num_potentials each)
+//   uint8 fairness penalty per freelancer, when fairness_weight > 0
+//   FairnessCounter history (num_history records)
+#define SNAPSHOT_MAGIC 0x4E535046u  // "FPSN"
+#define SNAPSHOT_FORMAT 6
+
+typedef struct {
+    uint32_t magic;
+    uint32_t format;
+    uint32_t checksums[DATASET_FILES];
+    uint32_t skills_checksum;   // alias and similarity tables scored with
+    int32_t min_experience_percent;
+    int32_t fairness_weight;
+    int32_t num_history;
+    int32_t num_freelancers;
+    int32_t num_projects;
+    int32_t num_potentials;
+    int32_t has_potentials;     // 0 when the solve left no duals (sharded)
+    int32_t cost_scale;         // cost units per score point behind the duals
+} SnapshotHeader;
+
+static char snapshot_path[512];
+
+void match_results_set_snapshot_path(const char* path) {
+    snprintf(snapshot_path, sizeof(snapshot_path), "%s", path ? path : "");
+}
+
+static int save_snapshot(const MatchResult* result) {
+    if (!snapshot_path[0]) return 0;
+
+    // Write beside the target and rename, so a crash never leaves half a file
+    char temp_path[sizeof(snapshot_path) + 8];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", snapshot_path);
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) {
+        printf("Error writing snapshot file: %s\n", temp_path);
+        return 0;
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SNAPSHOT_MAGIC;
+    header.format = SNAPSHOT_FORMAT;
+    memcpy(header.checksums, result->checksums, sizeof(header.checksums));
+    header.skills_checksum = skills_tables_checksum();
+    header.min_experience_percent = min_experience_percent();
+    header.fairness_weight = result->row_penalty ? fairness_weight() : 0;
+    FairnessCounter* history = NULL;
+    header.num_history = fairness_export(&history);
+    if (header.num_history < 0) {
+        fclose(file);
+        remove(temp_path);
+        return 0;
+    }
+    header.num_freelancers = result->num_freelancers;
+    header.num_projects = result->num_projects;
+    header.num_potentials = result->num_potentials;
+    header.has_potentials = result->has_potentials;
+    header.cost_scale = result->cost_scale;
+
+    size_t n = result->num_potentials;
+    size_t f = result->num_freelancers;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(result->freelancer_project, sizeof(int), f, file) == f &&
+             fwrite(result->freelancer_score, sizeof(int), f, file) == f &&
+             fwrite(result->row_potential, sizeof(int), n, file) == n &&
+             fwrite(result->col_potential, sizeof(int), n, file) == n &&
+             (!header.fairness_weight || fwrite(result->row_penalty, 1, f, file) == f) &&
+             fwrite(history, sizeof(FairnessCounter), header.num_history, file) ==
+                 (size_t)header.num_history;
+    free(history);
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temp_path, snapshot_path) != 0) {
+        printf("Error writing snapshot file: %s\n", snapshot_path);
+        remove(temp_path);
+        return 0;
+    }
+    return 1;
+}
+
+// Make `fresh` the current result, taking ownership of its buffers
+static void install_result(MatchResult* fresh) {
+    fresh->solve_count = current.solve_count + 1;
+    if (current_loaded) {
+        match_results_free(&current);
+    }
+    current = *fresh;
+    current_loaded = 1;
+    if (!current.from_snapshot) {
+        fairness_record(current.freelancers, current.num_freelancers, current.freelancer_project);
+        save_snapshot(&current);
+    }
+}
+
+const MatchResult* match_results_current(int* refreshed) {
+    uint64_t version = dataset_version();
+    *refreshed = 0;
+    if (current_loaded && current.version == version) {
+        return &current;
+    }
+
+    // Start from the previous duals; the solver ignores them if the size changed
+    if (current_loaded) {
+        results_workspace.seed_col_potential = current.col_potential;
+        results_workspace.seed_size = current.num_potentials;
+        results_workspace.seed_scale = current.cost_scale;
+    } else {
+        results_workspace.seed_col_potential = snapshot_seed;
+        results_workspace.seed_size = snapshot_seed_size;
+        results_workspace.seed_scale = snapshot_seed_scale;
+    }
+    MatchResult fresh;
+    int built = match_results_build(&fresh, version, NULL);
+    results_workspace.seed_col_potential = NULL;
+    results_workspace.seed_size = 0;
+    results_workspace.seed_scale = 0;
+    free(snapshot_seed);
+    snapshot_seed = NULL;
+    snapshot_seed_size = 0;
+    if (!built) {
+        return current_loaded ? &current : NULL;
+    }
+    install_result(&fresh);
+    *refreshed = 1;
+    return &current;
+}
+
+int match_results_is_current(uint64_t version) {
+    return current_loaded && current.version == version;
+}
+
+int match_results_adopt(MatchResult* result) {
+    if (result->version != dataset_version() || match_results_is_current(result->version)) {
+        match_results_free(result);
+        return 0;
+    }
+    install_result(result);
+    return 1;
+}
+
+int match_results_warm_start(void) {
+    if (!snapshot_path[0]) return 0;
+    FILE* file = fopen(snapshot_path, "rb");
+    if (!file) return 0;
+
+    SnapshotHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != SNAPSHOT_MAGIC || header.format != SNAPSHOT_FORMAT) {
+        printf("Ignoring unreadable snapshot %s\n", snapshot_path);
+        fclose(file);
+        return 0;
+    }
+
+    // The workload history carries over whether or not the data still matches
+    long history_offset = (long)sizeof(header) +
+                          (2L * header.num_freelancers + 2L * header.num_potentials) * (long)sizeof(int) +
+                          (header.fairness_weight ? header.num_freelancers : 0);
+    FairnessCounter* history = (FairnessCounter*)malloc((header.num_history + 1) * sizeof(FairnessCounter));
+    if (history && header.num_history >= 0 && fseek(file, history_offset, SEEK_SET) == 0 &&
+        fread(history, sizeof(FairnessCounter), header.num_history, file) == (size_t)header.num_history) {
+        fairness_import(history, header.num_history);
+    }
+    free(history);
+    fseek(file, (long)sizeof(header), SEEK_SET);
+
+    // The snapshot is only valid for byte-identical CSV files and the same
+    // scoring settings
+    MatchResult result;
+    if (!load_dataset(&result, dataset_version())) {
+        fclose(file);
+        return 0;
+    }
+    if (memcmp(header.checksums, result.checksums, sizeof(header.checksums)) != 0 ||
+        header.skills_checksum != skills_tables_checksum() ||
+        header.min_experience_percent != min_experience_percent() ||
+        header.fairness_weight != fairness_weight() ||
+        header.num_freelancers != result.num_freelancers ||
+        header.num_projects != result.num_projects ||
+        header.num_potentials != result.num_potentials) {
+        // The duals still seed the first solve when the problem size is
+        // unchanged; the solver rescales them to its own cost scale
+        if (header.num_potentials == result.num_potentials && header.num_potentials > 0 &&
+            header.has_potentials && header.cost_scale > 0) {
+            long duals_offset = (long)sizeof(header) + 2L * header.num_freelancers * (long)sizeof(int) +
+                                (long)header.num_potentials * (long)sizeof(int);
+            snapshot_seed = (int*)malloc(header.num_potentials * sizeof(int));
+            if (snapshot_seed && fseek(file, duals_offset, SEEK_SET) == 0 &&
+                fread(snapshot_seed, sizeof(int), header.num_potentials, file) == (size_t)header.num_potentials) {
+                snapshot_seed_size = header.num_potentials;
+                snapshot_seed_scale = header.cost_scale;
+            } else {
+                free(snapshot_seed);
+                snapshot_seed = NULL;
+            }
+        }
+        printf("Snapshot %s does not match the current data; %s\n", snapshot_path,
+               snapshot_seed ? "its duals will seed the first solve" : "solving from scratch");
+        match_results_free(&result);
+        fclose(file);
+        return 0;
+    }
+
+    size_t n = result.num_potentials;
+    size_t f = result.num_freelancers;
+    int ok = fread(result.freelancer_project, sizeof(int), f, file) == f &&
+             fread(result.freelancer_score, sizeof(int), f, file) == f &&
+             fread(result.row_potential, sizeof(int), n, file) == n &&
+             fread(result.col_potential, sizeof(int), n, file) == n;
+    result.has_potentials = header.has_potentials;
+    result.cost_scale = header.cost_scale > 0 ? header.cost_scale : 1;
+    if (ok && header.fairness_weight) {
+        result.row_penalty = (uint8_t*)malloc(f + 1);
+        ok = result.row_penalty && fread(result.row_penalty, 1, f, file) == f;
+    }
+    fclose(file);
+
+    // Rebuild the assignment list, rejecting indices that do not fit the data
+    result.num_assignments = 0;
+    for (int i = 0; ok && i < result.num_freelancers; i++) {
+        int j = result.freelancer_project[i];
+        if (j < -1 || j >= result.num_projects) {
+            ok = 0;
+        } else if (j >= 0) {
+            Assignment* a = &result.assignments[result.num_assignments++];
+            a->freelancer_id = result.freelancers[i].id;
+            a->project_id = result.projects[j].id;
+            a->score = result.freelancer_score[i];
+        }
+    }
+    if (!ok) {
+        printf("Ignoring truncated snapshot %s\n", snapshot_path);
+        match_results_free(&result);
+        return 0;
+    }
+    for (int i = result.num_assignments; i < result.num_freelancers; i++) {
+        result.assignments[i].freelancer_id = -1;
+        result.assignments[i].project_id = -1;
+        result.assignments[i].score = 0;
+    }
+    metrics_set_gauge(GAUGE_ASSIGNMENTS, result.num_assignments);
+
+    if (!finish_result(&result)) return 0;
+    result.from_snapshot = 1;
+    install_result(&result);
+    printf("Warm start: restored %d assignments from %s\n", current.num_assignments, snapshot_path);
+    return 1;
+}
+
+// Append the solver's objective and bound to a /matches body
+static char* append_solver_info(const char* json, size_t length, const char* mode,
+                                const MatchQuality* quality) {
+    StringBuffer out;
+    strbuf_init(&out, length + 160);
+    // Drop the closing brace of the top-level object and reopen it
+    strbuf_appendf(&out, "%.*s", (int)(length - 1), json);
+    double gap = quality->upper_bound > 0 ?
+        (double)(quality->upper_bound - quality->objective) / quality->upper_bound * 100 : 0.0;
+    strbuf_appendf(&out, ",\"solver\":{\"mode\":\"%s\",\"objective\":%ld,\"upper_bound\":%ld,"
+                   "\"gap_percent\":%.2f}}", mode, quality->objective, quality->upper_bound, gap);
+    return strbuf_detach(&out);
+}
+
+char* match_results_greedy_json(void) {
+    // The exact answer is already at hand when the cache is current
+    uint64_t version = dataset_version();
+    if (match_results_is_current(version)) {
+        MatchQuality quality = { 0, 0 };
+        for (int a = 0; a < current.num_assignments; a++) {
+            quality.objective += current.assignments[a].score;
+        }
+        quality.upper_bound = quality.objective;
+        return append_solver_info(current.full_json, current.full_json_length, "exact", &quality);
+    }
+
+    MatchResult result;
+    if (!load_dataset(&result, version)) return NULL;
+    MatchQuality quality;
+    result.num_assignments = match_with_mode(&greedy_workspace, SOLVER_GREEDY,
+                                             result.freelancers, result.num_freelancers,
+                                             result.projects, result.num_projects,
+                                             result.assignments, &quality);
+    uint64_t stage_start = metrics_now_ns();
+    index_assignments(&result);
+    index_projects(&result);
+    char* json = format_matches_full_json(&result);
+    char* body = append_solver_info(json, strlen(json), "greedy", &quality);
+    metrics_observe_stage(STAGE_FORMAT_JSON, metrics_now_ns() - stage_start);
+    free(json);
+    match_results_free(&result);
+    return body;
+}
+
+char* match_results_explain_json(const MatchResult* result, int freelancer_id, int project_id) {
+    int i = match_results_find_id(result->freelancer_ids, result->num_freelancers, freelancer_id);
+    int j = match_results_find_id(result->project_ids, result->num_projects, project_id);
+    if (i < 0 || j < 0) return NULL;
+
+    // Same score and cost the solve used for this pair
+    int score = calculate_compatibility(&result->freelancers[i], &result->projects[j]);
+    int scale = result->cost_scale;
+    int penalty = result->row_penalty ? result->row_penalty[i] : 0;
+    int assigned_project = result->freelancer_project[i];
+    int project_owner = result->project_freelancer[j];
+
+    StringBuffer json;
+    strbuf_init(&json, 384);
+    strbuf_appendf(&json, "{\"freelancer_id\":%d,\"project_id\":%d,\"score\":%d,\"assigned\":%s,",
+                   freelancer_id, project_id, score, assigned_project == j ? "true" : "false");
+    if (assigned_project >= 0) {
+        strbuf_appendf(&json, "\"freelancer_assignment\":{\"project_id\":%d,\"score\":%d},",
+                       result->projects[assigned_project].id, result->freelancer_score[i]);
+    } else {
+        strbuf_appendf(&json, "\"freelancer_assignment\":null,");
+    }
+    if (project_owner >= 0) {
+        strbuf_appendf(&json, "\"project_assignment\":{\"freelancer_id\":%d,\"score\":%d},",
+                       result->freelancers[project_owner].id, result->freelancer_score[project_owner]);
+    } else {
+        strbuf_appendf(&json, "\"project_assignment\":null,");
+    }
+    strbuf_appendf(&json, "\"fairness_penalty\":%.2f,", (double)penalty / ROW_PENALTY_SCALE);
+
+    if (!result->has_potentials) {
+        // Sharded solves keep no duals
+        strbuf_appendf(&json, "\"reduced_cost\":null,\"min_score_increase\":null}");
+        return strbuf_detach(&json);
+    }
+
+    // Reduced cost c - u - v is zero on the assignment and never negative. A
+    // rise of d points lowers the pair's edge cost by d * scale, and while it
+    // stays at or above u + v the stored duals still prove the current
+    // assignment optimal, so no rise below the first d past that can change
+    // it. That is only a lower bound: other optimal duals may prove more, and
+    // finding the exact threshold would take a re-solve.
+    int duals = result->row_potential[i] + result->col_potential[j];
+    int edge_cost = solver_edge_cost(score, penalty, scale);
+    int cost = score > 0 ? edge_cost : solver_edge_cost(0, 0, scale);
+    strbuf_appendf(&json, "\"reduced_cost\":%.2f,", (double)(cost - duals) / scale);
+    if (assigned_project == j) {
+        strbuf_appendf(&json, "\"min_score_increase\":null}");
+    } else {
+        strbuf_appendf(&json, "\"min_score_increase\":%d}", (edge_cost - duals) / scale + 1);
+    }
+    return strbuf_detach(&json);
+}
+
+int match_results_entry_count(const MatchResult* result) {
+    return result->num_freelancers + result->num_unmatched_projects;
+}
+
+int parse_match_fields(const char* fields) {
+    if (strcmp(fields, "ids") == 0) return FIELDS_IDS;
+
+    int mask = 0;
+    const char* start = fields;
+    while (*start) {
+        size_t length = strcspn(start, ",");
+        if (length == 10 && strncmp(start, "freelancer", length) == 0) mask |= FIELD_FREELANCER;
+        else if (length == 7 && strncmp(start, "project", length) == 0) mask |= FIELD_PROJECT;
+        else if (length == 5 && strncmp(start, "score", length) == 0) mask |= FIELD_SCORE;
+        else if (length == 13 && strncmp(start, "freelancer_id", length) == 0) mask |= FIELD_FREELANCER_ID;
+        else if (length == 10 && strncmp(start, "project_id", length) == 0) mask |= FIELD_PROJECT_ID;
+        else return 0;
+        start += length;
+        if (*start == ',') start++;
+    }
+    return mask;
+}
+
+static void append_freelancer(StringBuffer* json, const Freelancer* f) {
+    strbuf_appendf(json, "{\"id\":%d,\"name\":\"%s\",\"experience\":%d,\"skills\":[",
+                   f->id, f->name, f->experience);
+    for (int s = 0; s < f->num_skills; s++) {
+        strbuf_appendf(json, "%s\"%s\"", s > 0 ? "," : "", f->skills[s]);
+    }
+    strbuf_appendf(json, "]}");
+}
+
+static void append_project(StringBuffer* json, const Project* p) {
+    strbuf_appendf(json, "{\"id\":%d,\"name\":\"%s\",\"required_skills\":[", p->id, p->name);
+    for (int s = 0; s < p->num_required_skills; s++) {
+        strbuf_appendf(json, "%s\"%s\"", s > 0 ? "," : "", p->required_skills[s]);
+    }
+    strbuf_appendf(json, "],\"min_experience\":%d,\"deadline_days\":%d}",
+                   p->min_experience, p->deadline_days);
+}
+
+char* format_matches_full_json(const MatchResult* result) {
+    int num_freelancers = result->num_freelancers;
+    StringBuffer json;
+    strbuf_init(&json, (size_t)(num_freelancers + result->num_unmatched_projects + 1) * 256);
+    strbuf_appendf(&json, "{\"total_freelancers\":%d,\"total_projects\":%d,\"matches\":[",
+                   num_freelancers, result->num_projects);
+
+    int assigned_count = 0;
+    for (int i = 0; i < num_freelancers; i++) {
+        strbuf_appendf(&json, "%s{\"freelancer\":", i > 0 ? "," : "");
+        append_freelancer(&json, &result->freelancers[i]);
+        int j = result->freelancer_project[i];
+        if (j >= 0) {
+            strbuf_appendf(&json, ",\"project\":");
+            append_project(&json, &result->projects[j]);
+            strbuf_appendf(&json, ",\"score\":%d}", result->freelancer_score[i]);
+            assigned_count++;
+        } else {
+            strbuf_appendf(&json, ",\"project\":null,\"score\":0}");
+        }
+    }
+    for (int u = 0; u < result->num_unmatched_projects; u++) {
+        strbuf_appendf(&json, ",{\"freelancer\":null,\"project\":");
+        append_project(&json, &result->projects[result->unmatched_projects[u]]);
+        strbuf_appendf(&json, ",\"score\":0}");
+    }
+
+    strbuf_appendf(&json, "],\"statistics\":{\"assigned_count\":%d,\"assigned_percentage\":%.1f,"
+                   "\"unassigned_count\":%d,\"unassigned_percentage\":%.1f}}",
+                   assigned_count,
+                   (float)assigned_count / num_freelancers * 100,
+                   num_freelancers - assigned_count,
+                   (float)(num_freelancers - assigned_count) / num_freelancers * 100);
+    return strbuf_detach(&json);
+}
+
+char* format_matches_page_json(const MatchResult* result, int offset, int limit, int fields) {
+    int total = match_results_entry_count(result);
+    if (offset < 0) offset = 0;
+    if (offset > total) offset = total;
+    if (limit < 0 || limit > total - offset) limit = total - offset;
+
+    StringBuffer json;
+    int per_entry = (fields & (FIELD_FREELANCER | FIELD_PROJECT)) ? 256 : 64;
+    strbuf_init(&json, 128 + (size_t)limit * per_entry);
+    strbuf_appendf(&json,
+                   "{\"total_freelancers\":%d,\"total_projects\":%d,\"total_entries\":%d,"
+                   "\"dataset_version\":\"%016llx\",\"offset\":%d,\"limit\":%d,\"matches\":[",
+                   result->num_freelancers, result->num_projects, total,
+                   (unsigned long long)result->version, offset, limit);
+
+    for (int e = offset; e < offset + limit; e++) {
+        const Freelancer* freelancer = NULL;
+        const Project* project = NULL;
+        int score = 0;
+        if (e < result->num_freelancers) {
+            freelancer = &result->freelancers[e];
+            int j = result->freelancer_project[e];
+            if (j >= 0) {
+                project = &result->projects[j];
+                score = result->freelancer_score[e];
+            }
+        } else {
+            project = &result->projects[result->unmatched_projects[e - result->num_freelancers]];
+        }
+
+        strbuf_appendf(&json, "%s{", e > offset ? "," : "");
+        const char* separator = "";
+        if (fields & FIELD_FREELANCER_ID) {
+            if (freelancer) strbuf_appendf(&json, "\"freelancer_id\":%d", freelancer->id);
+            else strbuf_appendf(&json, "\"freelancer_id\":null");
+            separator = ",";
+        }
+        if (fields & FIELD_PROJECT_ID) {
+            if (project) strbuf_appendf(&json, "%s\"project_id\":%d", separator, project->id);
+            else strbuf_appendf(&json, "%s\"project_id\":null", separator);
+            separator = ",";
+        }
+        if (fields & FIELD_FREELANCER) {
+            strbuf_appendf(&json, "%s\"freelancer\":", separator);
+            if (freelancer) append_freelancer(&json, freelancer);
+            else strbuf_appendf(&json, "null");
+            separator = ",";
+        }
+        if (fields & FIELD_PROJECT) {
+            strbuf_appendf(&json, "%s\"project\":", separator);
+            if (project) append_project(&json, project);
+            else strbuf_appendf(&json, "null");
+            separator = ",";
+        }
+        if (fields & FIELD_SCORE) {
+            strbuf_appendf(&json, "%s\"score\":%d", separator, score);
+        }
+        strbuf_appendf(&json, "}");
+    }
+    strbuf_appendf(&json, "]}");
+    return strbuf_detach(&json);
+}
@@ -0,0 +1,128 @@
+#ifndef MATCH_RESULTS_H
+#define MATCH_RESULTS_H
+
+#include "utils.h"
+#include "compression.h"
+#include "match_allocator.h"
+
+#define FREELANCERS_CSV "../data/freelancers.csv"
+#define PROJECTS_CSV "../data/projects.csv"
+#define AVAILABILITY_CSV "../data/availability.csv"
+#define DATASET_FILES 3
+
+// Last solved assignment and duals, reloaded on startup (FREELANCER_SNAPSHOT overrides)
+#define SNAPSHOT_FILE "../data/matches.snapshot"
+
+// Fields that can be projected into /matches entries
+#define FIELD_FREELANCER    0x01  // full freelancer object
+#define FIELD_PROJECT       0x02  // full project object
+#define FIELD_SCORE         0x04
+#define FIELD_FREELANCER_ID 0x08
+#define FIELD_PROJECT_ID    0x10
+#define FIELDS_DEFAULT (FIELD_FREELANCER | FIELD_PROJECT | FIELD_SCORE)
+#define FIELDS_IDS (FIELD_FREELANCER_ID | FIELD_PROJECT_ID | FIELD_SCORE)
+
+// Row index of an id, for lookups by freelancer or project id
+typedef struct {
+    int id;
+    int index;
+} IdIndex;
+
+// Row of `id` in a table sorted by id (ties in row order), or -1
+int match_results_find_id(const IdIndex* table, int count, int id);
+
+// A solved dataset and everything derived from it. Built once per change of
+// the CSV files and shared by every /matches request until the next change.
+// Entries are listed freelancers first, then the projects nobody took.
+typedef struct {
+    uint64_t version;           // fingerprint of the CSV files it was built from
+    uint64_t solve_count;       // number of solves so far, bumped on every rebuild
+    uint32_t checksums[DATASET_FILES];  // CRC-32 of each CSV file
+    int from_snapshot;          // restored by match_results_warm_start()
+    Freelancer* freelancers;
+    int num_freelancers;
+    Project* projects;
+    int num_projects;
+    Assignment* assignments;
+    int num_assignments;
+    int* freelancer_project;    // project index per freelancer, -1 if unassigned
+    int* freelancer_score;      // score per freelancer, 0 if unassigned
+    int* unmatched_projects;    // indices of projects with no freelancer
+    int* project_freelancer;    // freelancer index per project, -1 if unmatched
+    IdIndex* freelancer_ids;    // freelancers sorted by id
+    IdIndex* project_ids;       // projects sorted by id
+    int num_unmatched_projects;
+    char* full_json;            // default /matches body
+    size_t full_json_length;
+    char* summary_json;         // /matches/summary body
+    size_t summary_json_length;
+    CompressedBody full_json_compressed[ENCODING_COUNT];     // per coding, identity unused
+    CompressedBody summary_json_compressed[ENCODING_COUNT];
+    int* row_potential;         // solver duals u per row (num_potentials entries)
+    int* col_potential;         // solver duals v per column
+    int num_potentials;         // size of the padded square problem
+    int has_potentials;         // the potentials are the optimal duals of this solve
+    int cost_scale;             // cost units per score point behind the duals
+    uint8_t* row_penalty;       // fairness penalty per freelancer, NULL when off
+} MatchResult;
+
+// Fingerprint of the CSV files (size, mtime, inode)
+uint64_t dataset_version(void);
+
+// Result for the current CSV files; re-reads and re-solves only when they have
+// changed. Sets *refreshed when a new solve happened. Returns NULL if the
+// data could not be loaded.
+const MatchResult* match_results_current(int* refreshed);
+
+// Read and solve the CSV files into `result`. Solves on `workspace`, or on the
+// main thread's workspace when it is NULL; the workspace's progress, if any, is
+// updated and checked for cancellation. Returns 0 on failure or cancellation.
+// Safe to call off the main thread with a private workspace.
+int match_results_build(MatchResult* result, uint64_t version, SolverWorkspace* workspace);
+void match_results_free(MatchResult* result);
+
+// Where solved results are persisted; "" disables snapshots
+void match_results_set_snapshot_path(const char* path);
+
+// Install the persisted result if its CSV checksums match the files on disk,
+// so the first request after a restart does not re-solve. A snapshot of
+// changed data of the same size still seeds the first solve with its duals.
+// Returns 1 if the snapshot result was installed.
+int match_results_warm_start(void);
+
+// Whether the cached result was built from dataset `version`
+int match_results_is_current(uint64_t version);
+
+// Make a result built elsewhere the cached one if it matches the CSV files on
+// disk and is newer than the cache. Takes ownership either way; returns 1 if
+// it was installed. Main thread only.
+int match_results_adopt(MatchResult* result);
+
+// /matches?mode=greedy body: the greedy matching of the current CSV files
+// plus a "solver" object with its objective, upper bound and gap. Serves the
+// cached exact result instead when it is current. Caller frees; NULL if the
+// data could not be loaded. Main thread only.
+char* match_results_greedy_json(void);
+
+// /explain body for one freelancer/project pair: its score, the reduced cost
+// under the stored duals and the smallest score rise that could change the
+// assignment. No solve; caller frees. NULL if either id is unknown.
+char* match_results_explain_json(const MatchResult* result, int freelancer_id, int project_id);
+
+// Total number of /matches entries
+int match_results_entry_count(const MatchResult* result);
+
+// Level used for the bodies compressed once per solve
+#define CACHED_COMPRESSION_LEVEL 6
+
+// Parse a fields= list ("ids" or comma-separated field names); 0 if invalid
+int parse_match_fields(const char* fields);
+
+// The full default /matches body, written from the result's indexes (the
+// same bytes as format_matches_json); caller frees
+char* format_matches_full_json(const MatchResult* result);
+
+// One page of /matches entries with the selected fields; caller frees
+char* format_matches_page_json(const MatchResult* result, int offset, int limit, int fields);
+
+#endif // MATCH_RESULTS_H
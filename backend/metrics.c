@@ -0,0 +1,130 @@
+#include "metrics.h"
+#include "utils.h"
+#include <stdatomic.h>
+
+// Latency histograms use power-of-two nanosecond buckets: bucket k counts
+// observations in [2^k, 2^(k+1)) ns, which covers 1ns to ~18 minutes
+#define HISTOGRAM_BUCKETS 40
+
+typedef struct {
+    _Atomic uint64_t buckets[HISTOGRAM_BUCKETS];
+    _Atomic uint64_t count;
+    _Atomic uint64_t sum_ns;
+} LatencyHistogram;
+
+static const char* stage_names[STAGE_COUNT] = {
+    "load_csv", "bloom", "build_graph", "hungarian", "greedy", "sharded",
+    "format_json", "compress", "write_response", "request_total"
+};
+
+static const char* endpoint_names[ENDPOINT_COUNT] = {
+    "matches", "matches_summary", "schedule", "jobs", "freelancers_with_skill", "skill_exists",
+    "explain", "metrics", "options", "not_found"
+};
+
+static const char* gauge_names[GAUGE_COUNT] = {
+    "freelancer_dataset_freelancers",
+    "freelancer_dataset_projects",
+    "freelancer_graph_edges",
+    "freelancer_assignments",
+    "freelancer_solver_workspace_bytes"
+};
+
+static atomic_int enabled = 1;
+static LatencyHistogram stage_histograms[STAGE_COUNT];
+static _Atomic uint64_t request_counts[ENDPOINT_COUNT];
+static _Atomic int64_t gauges[GAUGE_COUNT];
+
+void metrics_set_enabled(int value) {
+    atomic_store_explicit(&enabled, value != 0, memory_order_relaxed);
+}
+
+int metrics_enabled(void) {
+    return atomic_load_explicit(&enabled, memory_order_relaxed);
+}
+
+static int bucket_for(uint64_t elapsed_ns) {
+    if (elapsed_ns == 0) return 0;
+    int bucket = 63 - __builtin_clzll(elapsed_ns);
+    return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+void metrics_observe_stage(MetricsStage stage, uint64_t elapsed_ns) {
+    if (!metrics_enabled()) return;
+    LatencyHistogram* histogram = &stage_histograms[stage];
+    atomic_fetch_add_explicit(&histogram->buckets[bucket_for(elapsed_ns)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->sum_ns, elapsed_ns, memory_order_relaxed);
+}
+
+void metrics_count_request(MetricsEndpoint endpoint) {
+    if (!metrics_enabled()) return;
+    atomic_fetch_add_explicit(&request_counts[endpoint], 1, memory_order_relaxed);
+}
+
+void metrics_set_gauge(MetricsGauge gauge, int64_t value) {
+    if (!metrics_enabled()) return;
+    atomic_store_explicit(&gauges[gauge], value, memory_order_relaxed);
+}
+
+uint64_t metrics_stage_quantile_ns(MetricsStage stage, double quantile) {
+    LatencyHistogram* histogram = &stage_histograms[stage];
+    uint64_t snapshot[HISTOGRAM_BUCKETS];
+    uint64_t total = 0;
+    for (int k = 0; k < HISTOGRAM_BUCKETS; k++) {
+        snapshot[k] = atomic_load_explicit(&histogram->buckets[k], memory_order_relaxed);
+        total += snapshot[k];
+    }
+    if (total == 0) return 0;
+
+    // Interpolate linearly inside the bucket holding the target rank
+    double rank = quantile * total;
+    uint64_t seen = 0;
+    for (int k = 0; k < HISTOGRAM_BUCKETS; k++) {
+        if (snapshot[k] == 0) continue;
+        if (seen + snapshot[k] >= rank) {
+            double lower = (double)(1ull << k);
+            double fraction = (rank - seen) / snapshot[k];
+            return (uint64_t)(lower + fraction * lower);
+        }
+        seen += snapshot[k];
+    }
+    return 1ull << (HISTOGRAM_BUCKETS - 1);
+}
+
+char* metrics_format_prometheus(double bloom_fill_ratio) {
+    StringBuffer out;
+    strbuf_init(&out, 4096);
+
+    strbuf_appendf(&out, "# HELP freelancer_requests_total Requests handled by endpoint.\n"
+                         "# TYPE freelancer_requests_total counter\n");
+    for (int e = 0; e < ENDPOINT_COUNT; e++) {
+        strbuf_appendf(&out, "freelancer_requests_total{endpoint=\"%s\"} %llu\n", endpoint_names[e],
+                       (unsigned long long)atomic_load_explicit(&request_counts[e], memory_order_relaxed));
+    }
+
+    strbuf_appendf(&out, "# HELP freelancer_stage_latency_seconds Latency of each /matches pipeline stage.\n"
+                         "# TYPE freelancer_stage_latency_seconds summary\n");
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        LatencyHistogram* histogram = &stage_histograms[s];
+        strbuf_appendf(&out, "freelancer_stage_latency_seconds{stage=\"%s\",quantile=\"0.5\"} %.9f\n",
+                       stage_names[s], metrics_stage_quantile_ns(s, 0.5) * 1e-9);
+        strbuf_appendf(&out, "freelancer_stage_latency_seconds{stage=\"%s\",quantile=\"0.99\"} %.9f\n",
+                       stage_names[s], metrics_stage_quantile_ns(s, 0.99) * 1e-9);
+        strbuf_appendf(&out, "freelancer_stage_latency_seconds_sum{stage=\"%s\"} %.9f\n", stage_names[s],
+                       atomic_load_explicit(&histogram->sum_ns, memory_order_relaxed) * 1e-9);
+        strbuf_appendf(&out, "freelancer_stage_latency_seconds_count{stage=\"%s\"} %llu\n", stage_names[s],
+                       (unsigned long long)atomic_load_explicit(&histogram->count, memory_order_relaxed));
+    }
+
+    for (int g = 0; g < GAUGE_COUNT; g++) {
+        strbuf_appendf(&out, "# TYPE %s gauge\n%s %lld\n", gauge_names[g], gauge_names[g],
+                       (long long)atomic_load_explicit(&gauges[g], memory_order_relaxed));
+    }
+
+    strbuf_appendf(&out, "# HELP freelancer_bloom_fill_ratio Fraction of skill Bloom filter bits set.\n"
+                         "# TYPE freelancer_bloom_fill_ratio gauge\n"
+                         "freelancer_bloom_fill_ratio %.4f\n", bloom_fill_ratio);
+
+    return strbuf_detach(&out);
+}
@@ -0,0 +1,67 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include <time.h>
+
+// Pipeline stages timed for /metrics
+typedef enum {
+    STAGE_LOAD_CSV,
+    STAGE_BLOOM,
+    STAGE_BUILD_GRAPH,
+    STAGE_HUNGARIAN,
+    STAGE_GREEDY,
+    STAGE_SHARDED,
+    STAGE_FORMAT_JSON,
+    STAGE_COMPRESS,
+    STAGE_WRITE_RESPONSE,
+    STAGE_REQUEST_TOTAL,
+    STAGE_COUNT
+} MetricsStage;
+
+// Endpoints counted separately
+typedef enum {
+    ENDPOINT_MATCHES,
+    ENDPOINT_MATCHES_SUMMARY,
+    ENDPOINT_SCHEDULE,
+    ENDPOINT_JOBS,
+    ENDPOINT_FREELANCERS_WITH_SKILL,
+    ENDPOINT_SKILL_EXISTS,
+    ENDPOINT_EXPLAIN,
+    ENDPOINT_METRICS,
+    ENDPOINT_OPTIONS,
+    ENDPOINT_NOT_FOUND,
+    ENDPOINT_COUNT
+} MetricsEndpoint;
+
+// Last-observed values
+typedef enum {
+    GAUGE_FREELANCERS,
+    GAUGE_PROJECTS,
+    GAUGE_EDGES,
+    GAUGE_ASSIGNMENTS,
+    GAUGE_WORKSPACE_BYTES,
+    GAUGE_COUNT
+} MetricsGauge;
+
+// Monotonic clock in nanoseconds for stage timers
+static inline uint64_t metrics_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void metrics_set_enabled(int enabled);
+int metrics_enabled(void);
+
+void metrics_observe_stage(MetricsStage stage, uint64_t elapsed_ns);
+void metrics_count_request(MetricsEndpoint endpoint);
+void metrics_set_gauge(MetricsGauge gauge, int64_t value);
+
+// Estimated latency quantile (0-1) for a stage in nanoseconds
+uint64_t metrics_stage_quantile_ns(MetricsStage stage, double quantile);
+
+// Prometheus text exposition of all metrics; caller frees
+char* metrics_format_prometheus(double bloom_fill_ratio);
+
+#endif // METRICS_H
@@ -0,0 +1,122 @@
+#include "scheduler.h"
+#include "match_allocator.h"
+
+// Days on which a freelancer could start a project before its deadline.
+// Availability repeats weekly and each freelancer takes a single project, so
+// the time-expanded network over the horizon collapses to this one AND.
+static AvailabilityMask start_window(const Freelancer* freelancer, const Project* project) {
+    return freelancer->availability & deadline_mask(project->deadline_days);
+}
+
+int schedule_freelancers_to_projects(const Freelancer* freelancers, int num_freelancers,
+                                     const Project* projects, int num_projects,
+                                     ScheduledAssignment* schedule) {
+    BipartiteGraph* graph = create_graph(num_freelancers, num_projects);
+
+    // Only pairs with at least one shared day before the deadline become edges
+    int built = 1;
+    for (int i = 0; built && i < num_freelancers; i++) {
+        if (freelancers[i].availability == 0) continue;
+        for (int j = 0; built && j < num_projects; j++) {
+            if (!start_window(&freelancers[i], &projects[j])) continue;
+            int compatibility_score = calculate_compatibility(&freelancers[i], &projects[j]);
+            if (compatibility_score > 0) {
+                built = add_edge(graph, i, j + num_freelancers, compatibility_score);
+            }
+        }
+    }
+
+    // A graph missing edges would be scheduled as if it were complete
+    int* temp_assignments = built ? (int*)calloc(num_freelancers + 1, sizeof(int)) : NULL;
+    if (!temp_assignments) {
+        printf("Error: could not build the schedule graph\n");
+        free_graph(graph);
+        return 0;
+    }
+    hungarian_algorithm(graph, temp_assignments);
+
+    int num_scheduled = 0;
+    for (int i = 0; i < num_freelancers; i++) {
+        int j = temp_assignments[i];
+        if (j == -1) continue;
+
+        ScheduledAssignment* s = &schedule[num_scheduled++];
+        s->freelancer_id = freelancers[i].id;
+        s->project_id = projects[j].id;
+        s->score = calculate_compatibility(&freelancers[i], &projects[j]);
+        // Start on the earliest shared day
+        s->start_day = __builtin_ctz(start_window(&freelancers[i], &projects[j]));
+    }
+
+    free(temp_assignments);
+    free_graph(graph);
+    return num_scheduled;
+}
+
+char* format_schedule_json(const Freelancer* freelancers, int num_freelancers,
+                           const Project* projects, int num_projects,
+                           const ScheduledAssignment* schedule, int num_scheduled) {
+    StringBuffer json;
+    strbuf_init(&json, 256 + (size_t)num_scheduled * 128 + (size_t)num_projects * 16);
+
+    int horizon_days = 0;
+    for (int i = 0; i < num_projects; i++) {
+        if (projects[i].deadline_days > horizon_days) horizon_days = projects[i].deadline_days;
+    }
+    if (horizon_days > DAYS_PER_WEEK) horizon_days = DAYS_PER_WEEK;
+
+    strbuf_appendf(&json, "{\"horizon_days\":%d,\"scheduled\":[", horizon_days);
+    for (int i = 0; i < num_scheduled; i++) {
+        int deadline_days = 0;
+        for (int j = 0; j < num_projects; j++) {
+            if (projects[j].id == schedule[i].project_id) {
+                deadline_days = projects[j].deadline_days;
+                break;
+            }
+        }
+        strbuf_appendf(&json, "%s{\"freelancer_id\":%d,\"project_id\":%d,\"score\":%d,"
+                       "\"start_day\":%d,\"deadline_days\":%d}",
+                       i > 0 ? "," : "",
+                       schedule[i].freelancer_id, schedule[i].project_id,
+                       schedule[i].score, schedule[i].start_day, deadline_days);
+    }
+
+    // Projects left without a freelancer, for any reason
+    strbuf_appendf(&json, "],\"unscheduled_projects\":[");
+    int unscheduled_count = 0;
+    for (int j = 0; j < num_projects; j++) {
+        int scheduled = 0;
+        for (int i = 0; i < num_scheduled; i++) {
+            if (schedule[i].project_id == projects[j].id) {
+                scheduled = 1;
+                break;
+            }
+        }
+        if (!scheduled) {
+            strbuf_appendf(&json, "%s%d", unscheduled_count > 0 ? "," : "", projects[j].id);
+            unscheduled_count++;
+        }
+    }
+
+    // Projects nobody could start before their deadline. Any freelancer's
+    // start window is their availability cut at the deadline, so one OR over
+    // all availability answers it for every project.
+    AvailabilityMask any_available = 0;
+    for (int i = 0; i < num_freelancers; i++) {
+        any_available |= freelancers[i].availability;
+    }
+    strbuf_appendf(&json, "],\"missed_projects\":[");
+    int missed_count = 0;
+    for (int j = 0; j < num_projects; j++) {
+        if (!(any_available & deadline_mask(projects[j].deadline_days))) {
+            strbuf_appendf(&json, "%s%d", missed_count > 0 ? "," : "", projects[j].id);
+            missed_count++;
+        }
+    }
+
+    strbuf_appendf(&json, "],\"statistics\":{\"scheduled_count\":%d,\"unscheduled_count\":%d,"
+                   "\"missed_count\":%d}}",
+                   num_scheduled, unscheduled_count, missed_count);
+
+    return strbuf_detach(&json);
+}
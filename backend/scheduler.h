@@ -0,0 +1,28 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "utils.h"
+
+// Structure to store a scheduled assignment
+typedef struct {
+    int freelancer_id;
+    int project_id;
+    int score;
+    int start_day;  // first day (from the start of the horizon) the freelancer can begin
+} ScheduledAssignment;
+
+// Assign freelancers to projects so that every assignment can start on a day
+// the freelancer is available and before the project's deadline.
+// Returns the number of scheduled assignments written to schedule.
+int schedule_freelancers_to_projects(const Freelancer* freelancers, int num_freelancers,
+                                     const Project* projects, int num_projects,
+                                     ScheduledAssignment* schedule);
+
+// Function to format a schedule as JSON. unscheduled_projects lists every
+// project left without a freelancer; missed_projects only those no freelancer
+// is available to start before the deadline.
+char* format_schedule_json(const Freelancer* freelancers, int num_freelancers,
+                           const Project* projects, int num_projects,
+                           const ScheduledAssignment* schedule, int num_scheduled);
+
+#endif // SCHEDULER_H
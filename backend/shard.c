@@ -0,0 +1,609 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "shard.h"
+#include "match_allocator.h"
+
+// Message sent to a worker, followed by int32 row_start[rows + 1],
+// edge_col[edges] and edge_weight[edges] in shard-local numbering, then
+// uint8 row_penalty[rows] when has_penalty is set.
+// rows < 0 asks the worker to exit.
+typedef struct {
+    int32_t shard;
+    int32_t rows;
+    int32_t cols;
+    int32_t edges;
+    int32_t has_penalty;
+} ShardRequest;
+
+// Reply, followed by int32 local column per row (-1 when unmatched)
+typedef struct {
+    int32_t shard;
+    int32_t rows;
+} ShardReply;
+
+typedef struct {
+    int fd;
+    pid_t pid;
+} ShardWorker;
+
+// Compatibility scores run 0..100
+#define SHARD_MAX_SCORE 100
+
+static ShardWorker workers[SHARD_MAX_WORKERS];
+// Changed under pool_lock; atomic so shard_pool_size() can read it without
+// waiting for a sharded solve to finish
+static atomic_int num_workers;
+static int max_nodes = SHARD_DEFAULT_MAX_NODES;
+// One sharded solve at a time: the sockets carry a single conversation
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int write_all(int fd, const void* data, size_t length) {
+    const char* p = (const char*)data;
+    while (length > 0) {
+        ssize_t sent = send(fd, p, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return 0;
+        p += sent;
+        length -= (size_t)sent;
+    }
+    return 1;
+}
+
+static int read_all(int fd, void* data, size_t length) {
+    char* p = (char*)data;
+    while (length > 0) {
+        ssize_t got = read(fd, p, length);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return 0;
+        p += got;
+        length -= (size_t)got;
+    }
+    return 1;
+}
+
+// Grow an int array to hold at least `needed` entries
+static int reserve_ints(int** array, int* capacity, int needed) {
+    if (needed <= *capacity) return 1;
+    int grown = *capacity ? *capacity : 256;
+    while (grown < needed) grown *= 2;
+    int* resized = (int*)realloc(*array, (size_t)grown * sizeof(int));
+    if (!resized) return 0;
+    *array = resized;
+    *capacity = grown;
+    return 1;
+}
+
+static int reserve_bytes(uint8_t** array, int* capacity, int needed) {
+    if (needed <= *capacity) return 1;
+    int grown = *capacity ? *capacity : 256;
+    while (grown < needed) grown *= 2;
+    uint8_t* resized = (uint8_t*)realloc(*array, (size_t)grown);
+    if (!resized) return 0;
+    *array = resized;
+    *capacity = grown;
+    return 1;
+}
+
+// Worker process: solve shards until the coordinator goes away
+static void worker_loop(int fd) {
+    SolverWorkspace workspace;
+    solver_workspace_init(&workspace);
+    BipartiteGraph graph;
+    memset(&graph, 0, sizeof(graph));
+    int* row_start = NULL;
+    int* edge_col = NULL;
+    int* edge_weight = NULL;
+    uint8_t* row_penalty = NULL;
+    int row_capacity = 0, edge_capacity = 0, weight_capacity = 0, penalty_capacity = 0;
+
+    ShardRequest request;
+    while (read_all(fd, &request, sizeof(request)) && request.rows >= 0) {
+        int rows = request.rows;
+        int cols = request.cols;
+        int edges = request.edges;
+        if (!reserve_ints(&row_start, &row_capacity, rows + 1) ||
+            !reserve_ints(&edge_col, &edge_capacity, edges) ||
+            !reserve_ints(&edge_weight, &weight_capacity, edges) ||
+            !read_all(fd, row_start, (size_t)(rows + 1) * sizeof(int)) ||
+            !read_all(fd, edge_col, (size_t)edges * sizeof(int)) ||
+            !read_all(fd, edge_weight, (size_t)edges * sizeof(int))) {
+            break;
+        }
+        // Fairness penalties go into the worker's costs as they do in-process
+        workspace.row_penalty = NULL;
+        if (request.has_penalty) {
+            if (!reserve_bytes(&row_penalty, &penalty_capacity, rows + 1) ||
+                !read_all(fd, row_penalty, (size_t)rows)) {
+                break;
+            }
+            workspace.row_penalty = row_penalty;
+        }
+
+        reset_graph(&graph, rows, cols);
+        int built = 1;
+        for (int r = 0; built && r < rows; r++) {
+            for (int e = row_start[r]; built && e < row_start[r + 1]; e++) {
+                built = add_edge(&graph, r, rows + edge_col[e], edge_weight[e]);
+            }
+        }
+
+        // Hang up if the shard cannot be solved; the coordinator then stops
+        // using the pool and solves in-process
+        int* assignments = built ? (int*)malloc((size_t)(rows + 1) * sizeof(int)) : NULL;
+        if (!assignments || !hungarian_solve(&workspace, &graph, assignments)) {
+            free(assignments);
+            break;
+        }
+        ShardReply reply = { request.shard, rows };
+        int ok = write_all(fd, &reply, sizeof(reply)) &&
+                 write_all(fd, assignments, (size_t)rows * sizeof(int));
+        free(assignments);
+        if (!ok) break;
+    }
+
+    free(row_start);
+    free(edge_col);
+    free(edge_weight);
+    free(row_penalty);
+    free(graph.row_start);
+    free(graph.edge_project);
+    free(graph.edge_weight);
+    solver_workspace_free(&workspace);
+    close(fd);
+}
+
+int shard_pool_start(int count, int max_shard_nodes) {
+    if (count > SHARD_MAX_WORKERS) count = SHARD_MAX_WORKERS;
+    if (max_shard_nodes > 0) max_nodes = max_shard_nodes;
+
+    for (int w = 0; w < count; w++) {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) < 0) {
+            printf("Shard worker socketpair failed: %s\n", strerror(errno));
+            break;
+        }
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid < 0) {
+            printf("Shard worker fork failed: %s\n", strerror(errno));
+            close(pair[0]);
+            close(pair[1]);
+            break;
+        }
+        if (pid == 0) {
+            // Keep only this worker's end; the other sockets belong to the coordinator
+            for (int k = 0; k < num_workers; k++) close(workers[k].fd);
+            close(pair[0]);
+            worker_loop(pair[1]);
+            _exit(0);
+        }
+        close(pair[1]);
+        workers[num_workers].fd = pair[0];
+        workers[num_workers].pid = pid;
+        num_workers++;
+    }
+    if (num_workers > 0) {
+        printf("Started %d shard workers (max %d nodes per shard)\n", num_workers, max_nodes);
+    }
+    return num_workers;
+}
+
+void shard_pool_stop(void) {
+    pthread_mutex_lock(&pool_lock);
+    ShardRequest stop = { -1, -1, 0, 0, 0 };
+    for (int w = 0; w < num_workers; w++) {
+        write_all(workers[w].fd, &stop, sizeof(stop));
+        close(workers[w].fd);
+        waitpid(workers[w].pid, NULL, 0);
+    }
+    num_workers = 0;
+    pthread_mutex_unlock(&pool_lock);
+}
+
+int shard_pool_size(void) {
+    return atomic_load(&num_workers);
+}
+
+int shard_max_nodes(void) {
+    return max_nodes;
+}
+
+// Union-find root with path halving
+static int find_root(int* parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+// How the graph was cut. Nodes are numbered like add_edge(): freelancer i is
+// node i, project j is node num_freelancers + j.
+typedef struct {
+    int num_shards;
+    int* shard_of;        // shard of each node, -1 for nodes without edges
+    int* local_of;        // index of the node among its shard's rows or columns
+    int* row_offset;      // shard s owns rows row_list[row_offset[s] .. row_offset[s + 1])
+    int* row_list;
+    int* col_offset;      // and columns col_list[col_offset[s] .. col_offset[s + 1])
+    int* col_list;
+} ShardPlan;
+
+static void free_plan(ShardPlan* plan) {
+    free(plan->shard_of);
+    free(plan->local_of);
+    free(plan->row_offset);
+    free(plan->row_list);
+    free(plan->col_offset);
+    free(plan->col_list);
+}
+
+// Place `node` in the open shard, starting a new one when its side is full
+static void place_node(ShardPlan* plan, int node, int num_freelancers,
+                       int* open_rows, int* open_cols) {
+    int is_row = node < num_freelancers;
+    if ((is_row ? *open_rows : *open_cols) == max_nodes) {
+        plan->num_shards++;
+        *open_rows = 0;
+        *open_cols = 0;
+    }
+    plan->shard_of[node] = plan->num_shards - 1;
+    plan->local_of[node] = is_row ? (*open_rows)++ : (*open_cols)++;
+}
+
+// Cut the graph into shards: whole components packed first-fit in discovery
+// order, oversized components chopped into BFS-ordered chunks so most of
+// their edges stay inside a shard
+static int plan_shards(const BipartiteGraph* graph, ShardPlan* plan, ShardStats* stats) {
+    int num_freelancers = graph->num_freelancers;
+    int num_nodes = num_freelancers + graph->num_projects;
+    memset(plan, 0, sizeof(*plan));
+    int* parent = (int*)malloc((size_t)num_nodes * sizeof(int));
+    int* comp_rows = (int*)calloc(num_nodes, sizeof(int));
+    int* comp_cols = (int*)calloc(num_nodes, sizeof(int));
+    int* queue = (int*)malloc((size_t)num_nodes * sizeof(int));
+    int* col_start = (int*)calloc(graph->num_projects + 1, sizeof(int));
+    int* col_rows = (int*)malloc((size_t)(graph->num_edges + 1) * sizeof(int));
+    plan->shard_of = (int*)malloc((size_t)num_nodes * sizeof(int));
+    plan->local_of = (int*)malloc((size_t)num_nodes * sizeof(int));
+    int ok = parent && comp_rows && comp_cols && queue && col_start && col_rows &&
+             plan->shard_of && plan->local_of;
+
+    for (int x = 0; ok && x < num_nodes; x++) {
+        parent[x] = x;
+        plan->shard_of[x] = -1;
+    }
+    for (int i = 0; ok && i < num_freelancers; i++) {
+        for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+            int a = find_root(parent, i);
+            int b = find_root(parent, num_freelancers + graph->edge_project[e]);
+            if (a != b) parent[a] = b;
+            col_start[graph->edge_project[e] + 1]++;
+        }
+    }
+    // Column-major copy of the edges for walking from projects back to rows
+    for (int j = 0; ok && j < graph->num_projects; j++) col_start[j + 1] += col_start[j];
+    for (int i = 0; ok && i < num_freelancers; i++) {
+        for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+            col_rows[col_start[graph->edge_project[e]]++] = i;
+        }
+    }
+    for (int j = graph->num_projects; ok && j > 0; j--) col_start[j] = col_start[j - 1];
+    if (ok) col_start[0] = 0;
+
+    // Size every component; nodes without edges stay out of all shards
+    for (int i = 0; ok && i < num_freelancers; i++) {
+        if (graph_row_begin(graph, i) < graph_row_end(graph, i)) comp_rows[find_root(parent, i)]++;
+    }
+    for (int j = 0; ok && j < graph->num_projects; j++) {
+        if (col_start[j] < col_start[j + 1]) comp_cols[find_root(parent, num_freelancers + j)]++;
+    }
+
+    int open_rows = max_nodes, open_cols = max_nodes;
+    for (int x = 0; ok && x < num_nodes; x++) {
+        int root = find_root(parent, x);
+        if (root != x || comp_rows[root] + comp_cols[root] == 0) continue;
+        stats->components++;
+        int big = comp_rows[root] > max_nodes || comp_cols[root] > max_nodes;
+        if (big) {
+            stats->split_components++;
+        } else if (open_rows + comp_rows[root] > max_nodes ||
+                   open_cols + comp_cols[root] > max_nodes) {
+            plan->num_shards++;
+            open_rows = 0;
+            open_cols = 0;
+        }
+        // Walk the component breadth first from its root, which has edges
+        int head = 0, tail = 0;
+        queue[tail++] = x;
+        place_node(plan, x, num_freelancers, &open_rows, &open_cols);
+        while (head < tail) {
+            int node = queue[head++];
+            if (node < num_freelancers) {
+                for (int e = graph_row_begin(graph, node); e < graph_row_end(graph, node); e++) {
+                    int next = num_freelancers + graph->edge_project[e];
+                    if (plan->shard_of[next] >= 0) continue;
+                    place_node(plan, next, num_freelancers, &open_rows, &open_cols);
+                    queue[tail++] = next;
+                }
+            } else {
+                int j = node - num_freelancers;
+                for (int e = col_start[j]; e < col_start[j + 1]; e++) {
+                    int next = col_rows[e];
+                    if (plan->shard_of[next] >= 0) continue;
+                    place_node(plan, next, num_freelancers, &open_rows, &open_cols);
+                    queue[tail++] = next;
+                }
+            }
+        }
+    }
+
+    // Per-shard node lists in local order
+    plan->row_offset = (int*)calloc(plan->num_shards + 1, sizeof(int));
+    plan->col_offset = (int*)calloc(plan->num_shards + 1, sizeof(int));
+    plan->row_list = (int*)malloc((size_t)(num_freelancers + 1) * sizeof(int));
+    plan->col_list = (int*)malloc((size_t)(graph->num_projects + 1) * sizeof(int));
+    ok = ok && plan->row_offset && plan->col_offset && plan->row_list && plan->col_list;
+    for (int x = 0; ok && x < num_nodes; x++) {
+        int s = plan->shard_of[x];
+        if (s < 0) continue;
+        if (x < num_freelancers) plan->row_offset[s + 1]++;
+        else plan->col_offset[s + 1]++;
+    }
+    for (int s = 0; ok && s < plan->num_shards; s++) {
+        plan->row_offset[s + 1] += plan->row_offset[s];
+        plan->col_offset[s + 1] += plan->col_offset[s];
+    }
+    for (int x = 0; ok && x < num_nodes; x++) {
+        int s = plan->shard_of[x];
+        if (s < 0) continue;
+        if (x < num_freelancers) plan->row_list[plan->row_offset[s] + plan->local_of[x]] = x;
+        else plan->col_list[plan->col_offset[s] + plan->local_of[x]] = x - num_freelancers;
+    }
+
+    free(parent);
+    free(comp_rows);
+    free(comp_cols);
+    free(queue);
+    free(col_start);
+    free(col_rows);
+    if (!ok) free_plan(plan);
+    return ok;
+}
+
+// Edges of one shard in local numbering
+typedef struct {
+    int* row_start;
+    int* edge_col;
+    int* edge_weight;
+    uint8_t* row_penalty;
+    int row_capacity;
+    int edge_capacity;
+    int weight_capacity;
+    int penalty_capacity;
+} ShardBuffer;
+
+static int send_shard(const BipartiteGraph* graph, const uint8_t* row_penalty, const ShardPlan* plan,
+                      int shard, ShardBuffer* buffer, int fd) {
+    int first_row = plan->row_offset[shard];
+    int rows = plan->row_offset[shard + 1] - first_row;
+    int cols = plan->col_offset[shard + 1] - plan->col_offset[shard];
+    if (!reserve_ints(&buffer->row_start, &buffer->row_capacity, rows + 1)) return 0;
+    if (row_penalty) {
+        if (!reserve_bytes(&buffer->row_penalty, &buffer->penalty_capacity, rows + 1)) return 0;
+        for (int r = 0; r < rows; r++) {
+            buffer->row_penalty[r] = row_penalty[plan->row_list[first_row + r]];
+        }
+    }
+
+    int edges = 0;
+    for (int r = 0; r < rows; r++) {
+        int i = plan->row_list[first_row + r];
+        buffer->row_start[r] = edges;
+        int begin = graph_row_begin(graph, i), end = graph_row_end(graph, i);
+        if (!reserve_ints(&buffer->edge_col, &buffer->edge_capacity, edges + end - begin) ||
+            !reserve_ints(&buffer->edge_weight, &buffer->weight_capacity, edges + end - begin)) {
+            return 0;
+        }
+        for (int e = begin; e < end; e++) {
+            int node = graph->num_freelancers + graph->edge_project[e];
+            if (plan->shard_of[node] != shard) continue;
+            buffer->edge_col[edges] = plan->local_of[node];
+            buffer->edge_weight[edges] = graph->edge_weight[e];
+            edges++;
+        }
+    }
+    buffer->row_start[rows] = edges;
+
+    ShardRequest request = { shard, rows, cols, edges, row_penalty != NULL };
+    return write_all(fd, &request, sizeof(request)) &&
+           write_all(fd, buffer->row_start, (size_t)(rows + 1) * sizeof(int)) &&
+           write_all(fd, buffer->edge_col, (size_t)edges * sizeof(int)) &&
+           write_all(fd, buffer->edge_weight, (size_t)edges * sizeof(int)) &&
+           (!row_penalty || write_all(fd, buffer->row_penalty, (size_t)rows));
+}
+
+static int receive_shard(const ShardPlan* plan, int fd, ShardBuffer* buffer, int* assignments) {
+    ShardReply reply;
+    if (!read_all(fd, &reply, sizeof(reply)) || reply.shard < 0 || reply.shard >= plan->num_shards) {
+        return 0;
+    }
+    int first_row = plan->row_offset[reply.shard];
+    int rows = plan->row_offset[reply.shard + 1] - first_row;
+    if (reply.rows != rows || !reserve_ints(&buffer->row_start, &buffer->row_capacity, rows + 1) ||
+        !read_all(fd, buffer->row_start, (size_t)rows * sizeof(int))) {
+        return 0;
+    }
+    const int* cols = plan->col_list + plan->col_offset[reply.shard];
+    for (int r = 0; r < rows; r++) {
+        int local = buffer->row_start[r];
+        assignments[plan->row_list[first_row + r]] = local >= 0 ? cols[local] : -1;
+    }
+    return 1;
+}
+
+// Solver cost of the edge between freelancer i and project j, the cost of
+// no edge if there is none
+static int edge_cost_of(const BipartiteGraph* graph, const uint8_t* row_penalty, int scale,
+                        int i, int j) {
+    for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+        if (graph->edge_project[e] == j) {
+            return solver_edge_cost(graph->edge_weight[e], row_penalty ? row_penalty[i] : 0, scale);
+        }
+    }
+    return solver_edge_cost(0, 0, scale);
+}
+
+// Use the edges the cut separated. Cheapest first, in the order the workers'
+// costs put them (score, then fairness penalty): match two free ends, or move
+// a freelancer to a free project that costs less. Each move involves one row,
+// so the per-row penalty unit is enough to keep score first.
+static int reconcile(const BipartiteGraph* graph, const uint8_t* row_penalty, const ShardPlan* plan,
+                     int* assignments, ShardStats* stats) {
+    int num_freelancers = graph->num_freelancers;
+    int scale = row_penalty ? ROW_PENALTY_SCALE : 1;
+    int num_costs = (SHARD_MAX_SCORE + 1) * scale;
+    int* bucket_start = (int*)calloc(num_costs + 1, sizeof(int));
+    if (!bucket_start) return 0;
+
+    // Counting sort of the cut edges by ascending cost, as (row, edge) pairs
+    for (int i = 0; i < num_freelancers; i++) {
+        int penalty = row_penalty ? row_penalty[i] : 0;
+        for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+            if (plan->shard_of[i] == plan->shard_of[num_freelancers + graph->edge_project[e]]) continue;
+            bucket_start[solver_edge_cost(graph->edge_weight[e], penalty, scale) + 1]++;
+            stats->cross_edges++;
+        }
+    }
+    for (int b = 0; b < num_costs; b++) bucket_start[b + 1] += bucket_start[b];
+    int* cross = (int*)malloc((size_t)(2 * stats->cross_edges + 1) * sizeof(int));
+    int* project_taken = (int*)calloc(graph->num_projects + 1, sizeof(int));
+    int* row_cost = (int*)malloc((num_freelancers + 1) * sizeof(int));
+    if (!cross || !project_taken || !row_cost) {
+        free(bucket_start);
+        free(cross);
+        free(project_taken);
+        free(row_cost);
+        return 0;
+    }
+    for (int i = 0; i < num_freelancers; i++) {
+        int penalty = row_penalty ? row_penalty[i] : 0;
+        for (int e = graph_row_begin(graph, i); e < graph_row_end(graph, i); e++) {
+            if (plan->shard_of[i] == plan->shard_of[num_freelancers + graph->edge_project[e]]) continue;
+            int k = bucket_start[solver_edge_cost(graph->edge_weight[e], penalty, scale)]++;
+            cross[2 * k] = i;
+            cross[2 * k + 1] = e;
+        }
+    }
+
+    for (int i = 0; i < num_freelancers; i++) {
+        row_cost[i] = solver_edge_cost(0, 0, scale);
+        if (assignments[i] < 0) continue;
+        project_taken[assignments[i]] = 1;
+        row_cost[i] = edge_cost_of(graph, row_penalty, scale, i, assignments[i]);
+    }
+    for (int k = 0; k < stats->cross_edges; k++) {
+        int i = cross[2 * k];
+        int j = graph->edge_project[cross[2 * k + 1]];
+        int cost = solver_edge_cost(graph->edge_weight[cross[2 * k + 1]],
+                                    row_penalty ? row_penalty[i] : 0, scale);
+        if (project_taken[j] || cost >= row_cost[i]) continue;
+        if (assignments[i] >= 0) project_taken[assignments[i]] = 0;
+        assignments[i] = j;
+        project_taken[j] = 1;
+        row_cost[i] = cost;
+        stats->reconciled++;
+    }
+
+    free(bucket_start);
+    free(cross);
+    free(project_taken);
+    free(row_cost);
+    return 1;
+}
+
+int sharded_solve(const BipartiteGraph* graph, const uint8_t* row_penalty, int* assignments,
+                  ShardStats* stats) {
+    ShardStats local_stats;
+    if (!stats) stats = &local_stats;
+    memset(stats, 0, sizeof(*stats));
+
+    pthread_mutex_lock(&pool_lock);
+    if (num_workers == 0) {
+        pthread_mutex_unlock(&pool_lock);
+        return 0;
+    }
+    ShardPlan plan;
+    if (!plan_shards(graph, &plan, stats)) {
+        pthread_mutex_unlock(&pool_lock);
+        return 0;
+    }
+    stats->shards = plan.num_shards;
+    for (int i = 0; i < graph->num_freelancers; i++) assignments[i] = -1;
+
+    // Keep one shard in flight per worker; a worker is only written to while
+    // it is idle, so neither side can block the other
+    ShardBuffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    int in_flight[SHARD_MAX_WORKERS];
+    int next_shard = 0, done = 0, ok = 1;
+    for (int w = 0; w < num_workers; w++) {
+        in_flight[w] = 0;
+        if (ok && next_shard < plan.num_shards) {
+            ok = send_shard(graph, row_penalty, &plan, next_shard++, &buffer, workers[w].fd);
+            in_flight[w] = 1;
+        }
+    }
+    struct pollfd fds[SHARD_MAX_WORKERS];
+    while (ok && done < plan.num_shards) {
+        for (int w = 0; w < num_workers; w++) {
+            fds[w].fd = in_flight[w] ? workers[w].fd : -1;
+            fds[w].events = POLLIN;
+            fds[w].revents = 0;
+        }
+        if (poll(fds, num_workers, -1) < 0) {
+            if (errno == EINTR) continue;
+            ok = 0;
+            break;
+        }
+        for (int w = 0; ok && w < num_workers; w++) {
+            if (!fds[w].revents) continue;
+            ok = receive_shard(&plan, workers[w].fd, &buffer, assignments);
+            in_flight[w] = 0;
+            done++;
+            if (ok && next_shard < plan.num_shards) {
+                ok = send_shard(graph, row_penalty, &plan, next_shard++, &buffer, workers[w].fd);
+                in_flight[w] = 1;
+            }
+        }
+    }
+    if (!ok) {
+        // A worker died or the stream is out of step; stop using the pool
+        printf("Shard worker failed, falling back to single-process solving\n");
+        // Workers still running would never be reaped, so stop them first
+        for (int w = 0; w < num_workers; w++) {
+            close(workers[w].fd);
+            kill(workers[w].pid, SIGKILL);
+            waitpid(workers[w].pid, NULL, 0);
+        }
+        num_workers = 0;
+    }
+    pthread_mutex_unlock(&pool_lock);
+
+    ok = ok && reconcile(graph, row_penalty, &plan, assignments, stats);
+    free(buffer.row_start);
+    free(buffer.edge_col);
+    free(buffer.edge_weight);
+    free(buffer.row_penalty);
+    free_plan(&plan);
+    return ok;
+}
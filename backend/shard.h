@@ -0,0 +1,43 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+#include "utils.h"
+
+// Multi-process solving for graphs too large for one dense cost matrix.
+// Worker processes are forked once at startup and talk to the coordinator
+// over Unix socketpairs. The coordinator splits the graph along connected
+// components, packs them into shards of at most max_shard_nodes rows and
+// columns, and hands one shard at a time to each worker, which runs the
+// Hungarian solver on it. Components too large for one shard are cut in
+// BFS order; edges cut that way are reconciled greedily afterwards.
+#define SHARD_MAX_WORKERS 64
+#define SHARD_DEFAULT_MAX_NODES 2048
+
+typedef struct {
+    int shards;               // shards sent to workers
+    int components;           // connected components with at least one edge
+    int split_components;     // components larger than one shard
+    int cross_edges;          // edges between different shards
+    int reconciled;           // assignments made or changed on cross edges
+} ShardStats;
+
+// Fork the worker processes. Call before starting threads or opening the
+// listening socket. Returns the number of workers running.
+int shard_pool_start(int num_workers, int max_shard_nodes);
+void shard_pool_stop(void);
+
+// Workers available, 0 when sharding is off
+int shard_pool_size(void);
+
+// Largest rows or columns per shard; graphs with more go through the pool
+int shard_max_nodes(void);
+
+// Solve `graph` across the worker pool. assignments[i] receives the project
+// index for freelancer i, or -1. row_penalty (may be NULL) is the fairness
+// penalty per freelancer, applied as in hungarian_solve(). Exact when no
+// component had to be split. Returns 0 if the pool is unavailable or a
+// worker failed.
+int sharded_solve(const BipartiteGraph* graph, const uint8_t* row_penalty, int* assignments,
+                  ShardStats* stats);
+
+#endif // SHARD_H
@@ -0,0 +1,292 @@
+#include <ctype.h>
+#include <pthread.h>
+#include <zlib.h>
+#include "skills.h"
+
+// Open-addressing table from normalised name to id. Aliases are extra
+// entries pointing at their skill's id.
+typedef struct {
+    char name[MAX_SKILL_LENGTH];
+    SkillId id;
+    int used;
+} SkillEntry;
+
+static SkillEntry* table;
+static size_t table_capacity;   // power of two
+static size_t table_used;
+static int next_id;
+static char (*names)[MAX_SKILL_LENGTH];   // canonical name per id
+static int names_capacity;
+static uint32_t tables_crc;
+static pthread_mutex_t skills_lock = PTHREAD_MUTEX_INITIALIZER;
+
+SkillSimilarity skill_similarity = { 0, NULL, 0, NULL, NULL, NULL };
+
+void skill_normalize(const char* raw, char* out, size_t size) {
+    size_t k = 0;
+    for (const char* c = raw; *c && k + 1 < size; c++) {
+        if (*c == '.' || *c == '_' || *c == '-' || isspace((unsigned char)*c)) continue;
+        out[k++] = (char)tolower((unsigned char)*c);
+    }
+    out[k] = '\0';
+}
+
+// FNV-1a
+static size_t hash_name(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; *c; c++) {
+        hash ^= (unsigned char)*c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Slot holding `name`, or the empty slot where it belongs
+static SkillEntry* find_entry(const char* name) {
+    size_t mask = table_capacity - 1;
+    for (size_t i = hash_name(name) & mask;; i = (i + 1) & mask) {
+        if (!table[i].used || strcmp(table[i].name, name) == 0) return &table[i];
+    }
+}
+
+// Keep the table at most half full
+static int grow_table(void) {
+    if (table_capacity && (table_used + 1) * 2 <= table_capacity) return 1;
+    size_t capacity = table_capacity ? table_capacity * 2 : 256;
+    SkillEntry* grown = (SkillEntry*)calloc(capacity, sizeof(SkillEntry));
+    if (!grown) return 0;
+    SkillEntry* old = table;
+    size_t old_capacity = table_capacity;
+    table = grown;
+    table_capacity = capacity;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old[i].used) *find_entry(old[i].name) = old[i];
+    }
+    free(old);
+    return 1;
+}
+
+// Map a normalised name to `id` (a fresh id when id is SKILL_ID_NONE)
+static SkillId insert_locked(const char* name, SkillId id) {
+    if (!grow_table()) return SKILL_ID_NONE;
+    SkillEntry* entry = find_entry(name);
+    if (entry->used && id == SKILL_ID_NONE) return entry->id;
+    if (id == SKILL_ID_NONE) {
+        if (next_id >= MAX_SKILL_IDS) {
+            printf("Skill table full, ignoring skill: %s\n", name);
+            return SKILL_ID_NONE;
+        }
+        if (next_id == names_capacity) {
+            int capacity = names_capacity ? names_capacity * 2 : 256;
+            char (*grown)[MAX_SKILL_LENGTH] = realloc(names, (size_t)capacity * MAX_SKILL_LENGTH);
+            if (!grown) return SKILL_ID_NONE;
+            names = grown;
+            names_capacity = capacity;
+        }
+        id = (SkillId)next_id++;
+        snprintf(names[id], MAX_SKILL_LENGTH, "%s", name);
+    }
+    if (!entry->used) {
+        snprintf(entry->name, sizeof(entry->name), "%s", name);
+        entry->used = 1;
+        table_used++;
+    }
+    entry->id = id;
+    return id;
+}
+
+SkillId skill_intern(const char* raw) {
+    char name[MAX_SKILL_LENGTH];
+    skill_normalize(raw, name, sizeof(name));
+    pthread_mutex_lock(&skills_lock);
+    SkillId id = insert_locked(name, SKILL_ID_NONE);
+    pthread_mutex_unlock(&skills_lock);
+    return id;
+}
+
+SkillId skill_lookup(const char* raw) {
+    char name[MAX_SKILL_LENGTH];
+    skill_normalize(raw, name, sizeof(name));
+    pthread_mutex_lock(&skills_lock);
+    SkillId id = SKILL_ID_NONE;
+    if (table_capacity) {
+        SkillEntry* entry = find_entry(name);
+        if (entry->used) id = entry->id;
+    }
+    pthread_mutex_unlock(&skills_lock);
+    return id;
+}
+
+void skill_canonical(const char* raw, char* out, size_t size) {
+    char name[MAX_SKILL_LENGTH];
+    skill_normalize(raw, name, sizeof(name));
+    pthread_mutex_lock(&skills_lock);
+    const char* canonical = name;
+    if (table_capacity) {
+        SkillEntry* entry = find_entry(name);
+        if (entry->used) canonical = names[entry->id];
+    }
+    snprintf(out, size, "%s", canonical);
+    pthread_mutex_unlock(&skills_lock);
+}
+
+void skills_intern_list(const char skills[][MAX_SKILL_LENGTH], int count, SkillId* ids) {
+    for (int k = 0; k < count; k++) {
+        ids[k] = skill_intern(skills[k]);
+    }
+}
+
+// Split "a,b[,c]" in place; returns the number of fields
+static int split_fields(char* line, char** fields, int max_fields) {
+    line[strcspn(line, "\r\n")] = '\0';
+    int count = 0;
+    char* saveptr = NULL;
+    for (char* token = strtok_r(line, ",", &saveptr); token && count < max_fields;
+         token = strtok_r(NULL, ",", &saveptr)) {
+        fields[count++] = token;
+    }
+    return count;
+}
+
+int skills_load_aliases(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return -1;
+
+    char line[256];
+    int added = 0;
+    // Skip header
+    fgets(line, sizeof(line), file);
+    while (fgets(line, sizeof(line), file)) {
+        tables_crc = (uint32_t)crc32(tables_crc, (const Bytef*)line, (uInt)strlen(line));
+        char* fields[2];
+        if (split_fields(line, fields, 2) < 2) continue;
+        char alias[MAX_SKILL_LENGTH];
+        char skill[MAX_SKILL_LENGTH];
+        skill_normalize(fields[0], alias, sizeof(alias));
+        skill_normalize(fields[1], skill, sizeof(skill));
+
+        pthread_mutex_lock(&skills_lock);
+        SkillId id = insert_locked(skill, SKILL_ID_NONE);
+        if (id != SKILL_ID_NONE && insert_locked(alias, id) == id) added++;
+        pthread_mutex_unlock(&skills_lock);
+    }
+    fclose(file);
+    printf("Loaded %d skill aliases\n", added);
+    return added;
+}
+
+int skills_load_similarity(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return -1;
+
+    // Read the pairs first; the matrix is sized from the skills they name
+    int capacity = 256, count = 0;
+    SkillId* pairs = (SkillId*)malloc(capacity * 2 * sizeof(SkillId));
+    uint8_t* credits = (uint8_t*)malloc(capacity);
+    char line[256];
+    fgets(line, sizeof(line), file);
+    while (pairs && credits && fgets(line, sizeof(line), file)) {
+        tables_crc = (uint32_t)crc32(tables_crc, (const Bytef*)line, (uInt)strlen(line));
+        char* fields[3];
+        if (split_fields(line, fields, 3) < 3) continue;
+        int credit = atoi(fields[2]);
+        if (credit <= 0) continue;
+        if (credit > SKILL_FULL_CREDIT) credit = SKILL_FULL_CREDIT;
+        if (count == capacity) {
+            capacity *= 2;
+            SkillId* grown_pairs = (SkillId*)realloc(pairs, capacity * 2 * sizeof(SkillId));
+            if (grown_pairs) pairs = grown_pairs;
+            uint8_t* grown_credits = (uint8_t*)realloc(credits, capacity);
+            if (grown_credits) credits = grown_credits;
+            if (!grown_pairs || !grown_credits) break;
+        }
+        pairs[2 * count] = skill_intern(fields[0]);
+        pairs[2 * count + 1] = skill_intern(fields[1]);
+        credits[count] = (uint8_t)credit;
+        if (pairs[2 * count] != SKILL_ID_NONE && pairs[2 * count + 1] != SKILL_ID_NONE) count++;
+    }
+    fclose(file);
+
+    // Give each skill that appears a dense row
+    SkillSimilarity similarity = { next_id, NULL, 0, NULL, NULL, NULL };
+    similarity.slot = (uint16_t*)malloc((similarity.num_ids + 1) * sizeof(uint16_t));
+    int ok = pairs && credits && similarity.slot;
+    for (int id = 0; ok && id < similarity.num_ids; id++) similarity.slot[id] = SKILL_ID_NONE;
+    for (int k = 0; ok && k < 2 * count; k++) {
+        if (similarity.slot[pairs[k]] != SKILL_ID_NONE) continue;
+        if (similarity.size == MAX_SIMILAR_SKILLS) {
+            printf("Similarity file names more than %d skills: %s\n", MAX_SIMILAR_SKILLS, path);
+            ok = 0;
+            break;
+        }
+        similarity.slot[pairs[k]] = (uint16_t)similarity.size++;
+    }
+    if (ok) {
+        similarity.credit = (uint8_t*)calloc((size_t)similarity.size * similarity.size + 1, 1);
+        ok = similarity.credit != NULL;
+    }
+    for (int k = 0; ok && k < count; k++) {
+        int a = similarity.slot[pairs[2 * k]];
+        int b = similarity.slot[pairs[2 * k + 1]];
+        similarity.credit[(size_t)a * similarity.size + b] = credits[k];
+        similarity.credit[(size_t)b * similarity.size + a] = credits[k];
+    }
+
+    // Neighbour lists, so candidate generation need not scan whole rows
+    int neighbour_count = 0;
+    for (size_t c = 0; ok && c < (size_t)similarity.size * similarity.size; c++) {
+        neighbour_count += similarity.credit[c] > 0;
+    }
+    if (ok) {
+        similarity.neighbour_start = (int*)malloc((similarity.size + 1) * sizeof(int));
+        similarity.neighbours = (SkillId*)malloc((neighbour_count + 1) * sizeof(SkillId));
+        ok = similarity.neighbour_start && similarity.neighbours;
+    }
+    if (ok) {
+        SkillId* slot_id = (SkillId*)malloc((similarity.size + 1) * sizeof(SkillId));
+        ok = slot_id != NULL;
+        for (int id = 0; ok && id < similarity.num_ids; id++) {
+            if (similarity.slot[id] != SKILL_ID_NONE) slot_id[similarity.slot[id]] = (SkillId)id;
+        }
+        int filled = 0;
+        for (int a = 0; ok && a < similarity.size; a++) {
+            similarity.neighbour_start[a] = filled;
+            for (int b = 0; b < similarity.size; b++) {
+                if (similarity.credit[(size_t)a * similarity.size + b] > 0) {
+                    similarity.neighbours[filled++] = slot_id[b];
+                }
+            }
+        }
+        if (ok) similarity.neighbour_start[similarity.size] = filled;
+        free(slot_id);
+    }
+    free(pairs);
+    free(credits);
+    if (!ok) {
+        free(similarity.slot);
+        free(similarity.credit);
+        free(similarity.neighbour_start);
+        free(similarity.neighbours);
+        printf("Error loading skill similarity file: %s\n", path);
+        return -1;
+    }
+
+    free(skill_similarity.slot);
+    free(skill_similarity.credit);
+    free(skill_similarity.neighbour_start);
+    free(skill_similarity.neighbours);
+    skill_similarity = similarity;
+    printf("Loaded %d skill similarities over %d skills\n", count, similarity.size);
+    return count;
+}
+
+int skills_count(void) {
+    pthread_mutex_lock(&skills_lock);
+    int count = next_id;
+    pthread_mutex_unlock(&skills_lock);
+    return count;
+}
+
+uint32_t skills_tables_checksum(void) {
+    return tables_crc;
+}
@@ -0,0 +1,78 @@
+#ifndef SKILLS_H
+#define SKILLS_H
+
+#include "utils.h"
+
+// Skill names are interned to small integer ids when the CSV files are read,
+// so scoring compares integers instead of strings. Interning normalises the
+// name (ASCII lower case; '.', '_', '-' and spaces dropped, so "Node.js" and
+// "NodeJS" meet) and then resolves aliases ("ML" -> "machinelearning").
+#define SKILL_ID_NONE ((SkillId)0xFFFF)   // table full; never matches
+#define MAX_SKILL_IDS 0xFFFF
+#define SKILL_ALIASES_FILE "../data/skill_aliases.csv"
+#define MAX_SIMILAR_SKILLS 4096           // distinct skills in the similarity file
+#define SKILL_FULL_CREDIT 100
+
+// Writes the normalised form of `raw` (at most size - 1 characters) into out
+void skill_normalize(const char* raw, char* out, size_t size);
+
+// Id of a skill, adding it if new. Thread-safe.
+SkillId skill_intern(const char* raw);
+
+// Id of a known skill, SKILL_ID_NONE if it was never interned
+SkillId skill_lookup(const char* raw);
+
+// Canonical (normalised, alias-resolved) name of `raw`, for string-keyed
+// structures such as the Bloom filter
+void skill_canonical(const char* raw, char* out, size_t size);
+
+// Intern `count` names into ids
+void skills_intern_list(const char skills[][MAX_SKILL_LENGTH], int count, SkillId* ids);
+
+// Alias file: "alias,skill" per line after a header. Returns aliases added,
+// or -1 if the file cannot be opened.
+int skills_load_aliases(const char* path);
+
+// Similarity file: "skill_a,skill_b,credit" per line after a header, where
+// credit (0-100) is the partial credit either skill earns for the other.
+// Call before any worker thread starts. Returns pairs loaded, -1 on error.
+int skills_load_similarity(const char* path);
+
+// Ids handed out so far; every interned id is below this
+int skills_count(void);
+
+// CRC-32 over the alias and similarity files loaded, 0 when none were
+uint32_t skills_tables_checksum(void);
+
+// Dense partial-credit matrix over the skills named in the similarity file.
+// slot maps a skill id to its row, SKILL_ID_NONE for skills not in the file.
+typedef struct {
+    int num_ids;          // ids covered by slot
+    uint16_t* slot;
+    int size;             // rows (and columns) of credit
+    uint8_t* credit;
+    int* neighbour_start; // per row: neighbours[neighbour_start[r] .. neighbour_start[r + 1])
+    SkillId* neighbours;  // ids with non-zero credit against the row's skill
+} SkillSimilarity;
+
+extern SkillSimilarity skill_similarity;
+
+// Partial credit skill `have` earns towards required skill `want`, 0-100
+static inline int skill_similarity_credit(SkillId want, SkillId have) {
+    if (want >= skill_similarity.num_ids || have >= skill_similarity.num_ids) return 0;
+    uint16_t row = skill_similarity.slot[want];
+    uint16_t col = skill_similarity.slot[have];
+    if (row == SKILL_ID_NONE || col == SKILL_ID_NONE) return 0;
+    return skill_similarity.credit[(size_t)row * skill_similarity.size + col];
+}
+
+// Skills that give partial credit towards `id` (and earn it from `id`)
+static inline const SkillId* skill_similar(SkillId id, int* count) {
+    *count = 0;
+    if (id >= skill_similarity.num_ids || skill_similarity.slot[id] == SKILL_ID_NONE) return NULL;
+    int row = skill_similarity.slot[id];
+    *count = skill_similarity.neighbour_start[row + 1] - skill_similarity.neighbour_start[row];
+    return skill_similarity.neighbours + skill_similarity.neighbour_start[row];
+}
+
+#endif // SKILLS_H
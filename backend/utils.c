@@ -1,4 +1,46 @@
 #include "utils.h"
+#include "skills.h"
+#include <stdarg.h>
+
+void strbuf_init(StringBuffer* buffer, size_t initial_capacity) {
+    buffer->capacity = initial_capacity > 0 ? initial_capacity : 64;
+    buffer->data = (char*)malloc(buffer->capacity);
+    buffer->length = 0;
+    buffer->data[0] = '\0';
+}
+
+void strbuf_appendf(StringBuffer* buffer, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int needed = vsnprintf(buffer->data + buffer->length,
+                           buffer->capacity - buffer->length, format, args);
+    va_end(args);
+    if (needed < 0) return;
+
+    if (buffer->length + needed + 1 > buffer->capacity) {
+        // Grow geometrically and format again into the larger buffer
+        size_t capacity = buffer->capacity * 2;
+        while (capacity < buffer->length + needed + 1) capacity *= 2;
+        char* data = (char*)realloc(buffer->data, capacity);
+        if (!data) return;
+        buffer->data = data;
+        buffer->capacity = capacity;
+
+        va_start(args, format);
+        vsnprintf(buffer->data + buffer->length,
+                  buffer->capacity - buffer->length, format, args);
+        va_end(args);
+    }
+    buffer->length += needed;
+}
+
+// Hands ownership of the string to the caller
+char* strbuf_detach(StringBuffer* buffer) {
+    char* data = buffer->data;
+    buffer->data = NULL;
+    buffer->length = buffer->capacity = 0;
+    return data;
+}
 
 // Helper function to split a string by delimiter
 static void split_string(const char* str, char delimiter, char result[][MAX_SKILL_LENGTH], int* count) {
@@ -27,7 +69,29 @@ static void split_string(const char* str, char delimiter, char result[][MAX_SKIL
     *count = k;
 }
 
+// Number of data rows in a CSV file (the header is not counted)
+int count_csv_rows(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) return 0;
+
+    int rows = 0;
+    int c, previous = '\n';
+    while ((c = fgetc(file)) != EOF) {
+        if (c == '\n' && previous != '\n') rows++;
+        previous = c;
+    }
+    if (previous != '\n') rows++;
+
+    fclose(file);
+    return rows > 0 ? rows - 1 : 0;
+}
+
 void read_freelancers(const char* filename, Freelancer* freelancers, int* num_freelancers) {
+    read_freelancers_limit(filename, freelancers, MAX_FREELANCERS, num_freelancers);
+}
+
+void read_freelancers_limit(const char* filename, Freelancer* freelancers,
+                            int max_freelancers, int* num_freelancers) {
     FILE* file = fopen(filename, "r");
     if (!file) {
         printf("Error opening freelancers file: %s\n", filename);
@@ -40,37 +104,37 @@ void read_freelancers(const char* filename, Freelancer* freelancers, int* num_fr
     // Skip header
     fgets(line, sizeof(line), file);
     
-    while (fgets(line, sizeof(line), file) && *num_freelancers < MAX_FREELANCERS) {
+    while (fgets(line, sizeof(line), file) && *num_freelancers < max_freelancers) {
         Freelancer* f = &freelancers[*num_freelancers];
         char skills_str[256];
         
         // Remove newline if present
         line[strcspn(line, "\n")] = 0;
         
-        // Parse CSV line
-        char* token = strtok(line, ",");
+        // Parse CSV line (strtok_r: solve jobs read the files off the main thread)
+        char* saveptr = NULL;
+        char* token = strtok_r(line, ",", &saveptr);
         if (!token) continue;
         f->id = atoi(token);
         
-        token = strtok(NULL, ",");
+        token = strtok_r(NULL, ",", &saveptr);
         if (!token) continue;
         strncpy(f->name, token, MAX_NAME_LENGTH - 1);
         
-        token = strtok(NULL, ",");
+        token = strtok_r(NULL, ",", &saveptr);
         if (!token) continue;
         strncpy(skills_str, token, sizeof(skills_str) - 1);
         
-        token = strtok(NULL, ",");
+        token = strtok_r(NULL, ",", &saveptr);
         if (!token) continue;
         f->experience = atoi(token);
         
         // Split skills
         split_string(skills_str, ' ', f->skills, &f->num_skills);
+        skills_intern_list(f->skills, f->num_skills, f->skill_ids);
         
-        // Initialize availability to false
-        for (int i = 0; i < 7; i++) {
-            f->availability[i] = false;
-        }
+        // Initialize availability to no days
+        f->availability = 0;
         
         (*num_freelancers)++;
     }
@@ -80,6 +144,11 @@ void read_freelancers(const char* filename, Freelancer* freelancers, int* num_fr
 }
 
 void read_projects(const char* filename, Project* projects, int* num_projects) {
+    read_projects_limit(filename, projects, MAX_PROJECTS, num_projects);
+}
+
+void read_projects_limit(const char* filename, Project* projects,
+                         int max_projects, int* num_projects) {
     FILE* file = fopen(filename, "r");
     if (!file) {
         printf("Error opening projects file\n");
@@ -92,14 +161,19 @@ void read_projects(const char* filename, Project* projects, int* num_projects) {
     // Skip header
     fgets(line, sizeof(line), file);
     
-    while (fgets(line, sizeof(line), file) && *num_projects < MAX_PROJECTS) {
+    while (fgets(line, sizeof(line), file) && *num_projects < max_projects) {
         Project* p = &projects[*num_projects];
         char skills_str[256];
         
-        sscanf(line, "%d,%[^,],%[^,],%d,%d", 
-               &p->id, p->name, skills_str, &p->min_experience, &p->deadline_days);
+        int fields = sscanf(line, "%d,%[^,],%[^,],%d,%d",
+                            &p->id, p->name, skills_str, &p->min_experience, &p->deadline_days);
+        if (fields < 4) continue;
+        if (fields < 5) {
+            p->deadline_days = DEFAULT_DEADLINE_DAYS;
+        }
         
         split_string(skills_str, ' ', p->required_skills, &p->num_required_skills);
+        skills_intern_list(p->required_skills, p->num_required_skills, p->required_skill_ids);
         
         (*num_projects)++;
     }
@@ -132,9 +206,14 @@ void read_availability(const char* filename, Freelancer* freelancers, int num_fr
             for (int i = 0; i < num_freelancers; i++) {
                 if (freelancers[i].id == freelancer_id) {
                     // Convert project_id to day index (0-6)
-                    int day_index = (project_id - 101) % 7;
-                    if (day_index >= 0 && day_index < 7) {
-                        freelancers[i].availability[day_index] = (available == 1);
+                    int day_index = (project_id - 101) % DAYS_PER_WEEK;
+                    if (day_index >= 0 && day_index < DAYS_PER_WEEK) {
+                        AvailabilityMask day_bit = (AvailabilityMask)(1u << day_index);
+                        if (available == 1) {
+                            freelancers[i].availability |= day_bit;
+                        } else {
+                            freelancers[i].availability &= (AvailabilityMask)~day_bit;
+                        }
                         count++;
                     }
                     break;
@@ -151,7 +230,8 @@ int calculate_skill_mismatch(const Freelancer* freelancer, const Project* projec
     
     for (int i = 0; i < project->num_required_skills; i++) {
         for (int j = 0; j < freelancer->num_skills; j++) {
-            if (strcmp(project->required_skills[i], freelancer->skills[j]) == 0) {
+            if (project->required_skill_ids[i] == freelancer->skill_ids[j] &&
+                project->required_skill_ids[i] != SKILL_ID_NONE) {
                 matched_skills++;
                 break;
             }
@@ -167,9 +247,9 @@ int calculate_experience_mismatch(const Freelancer* freelancer, const Project* p
 }
 
 int calculate_availability_mismatch(const Freelancer* freelancer, const Project* project) {
-    int day_index = (project->id - 101) % 7;
-    if (day_index >= 0 && day_index < 7) {
-        return freelancer->availability[day_index] ? 0 : 1;
+    int day_index = (project->id - 101) % DAYS_PER_WEEK;
+    if (day_index >= 0 && day_index < DAYS_PER_WEEK) {
+        return (freelancer->availability >> day_index) & 1u ? 0 : 1;
     }
     return 1;
 }
@@ -192,37 +272,34 @@ void generate_cost_matrix(Freelancer* freelancers, int num_freelancers,
 char* format_matches_json(const Freelancer* freelancers, int num_freelancers,
                          const Project* projects, int num_projects,
                          const Assignment* assignments) {
-    // Calculate buffer size needed
-    int buffer_size = 1024 * 1024; // 1MB initial buffer
-    char* json = (char*)malloc(buffer_size);
-    int pos = 0;
+    // Roughly 256 bytes per row; the buffer grows if that is not enough
+    StringBuffer json;
+    strbuf_init(&json, (size_t)(num_freelancers + num_projects + 1) * 256);
     int assigned_count = 0;
     
     // Start JSON object
-    pos += snprintf(json + pos, buffer_size - pos, 
-                   "{\"total_freelancers\":%d,\"total_projects\":%d,\"matches\":[",
+    strbuf_appendf(&json, "{\"total_freelancers\":%d,\"total_projects\":%d,\"matches\":[",
                    num_freelancers, num_projects);
     
     // Add each freelancer with their match (or null if no match)
     for (int i = 0; i < num_freelancers; i++) {
         if (i > 0) {
-            pos += snprintf(json + pos, buffer_size - pos, ",");
+            strbuf_appendf(&json, ",");
         }
         
-        pos += snprintf(json + pos, buffer_size - pos,
-                       "{\"freelancer\":{\"id\":%d,\"name\":\"%s\",\"experience\":%d,\"skills\":[",
+        strbuf_appendf(&json, "{\"freelancer\":{\"id\":%d,\"name\":\"%s\",\"experience\":%d,\"skills\":[",
                        freelancers[i].id, freelancers[i].name, freelancers[i].experience);
         
         // Add skills
         for (int j = 0; j < freelancers[i].num_skills; j++) {
             if (j > 0) {
-                pos += snprintf(json + pos, buffer_size - pos, ",");
+                strbuf_appendf(&json, ",");
             }
-            pos += snprintf(json + pos, buffer_size - pos, "\"%s\"",
+            strbuf_appendf(&json, "\"%s\"",
                            freelancers[i].skills[j]);
         }
         
-        pos += snprintf(json + pos, buffer_size - pos, "]},");
+        strbuf_appendf(&json, "]},");
         
         // Find if this freelancer has an assignment
         int assigned = 0;
@@ -234,21 +311,19 @@ char* format_matches_json(const Freelancer* freelancers, int num_freelancers,
                 // Find the matching project
                 for (int k = 0; k < num_projects; k++) {
                     if (projects[k].id == assignments[j].project_id) {
-                        pos += snprintf(json + pos, buffer_size - pos,
-                                     "\"project\":{\"id\":%d,\"name\":\"%s\",\"required_skills\":[",
+                        strbuf_appendf(&json, "\"project\":{\"id\":%d,\"name\":\"%s\",\"required_skills\":[",
                                      projects[k].id, projects[k].name);
                         
                         // Add required skills
                         for (int l = 0; l < projects[k].num_required_skills; l++) {
                             if (l > 0) {
-                                pos += snprintf(json + pos, buffer_size - pos, ",");
+                                strbuf_appendf(&json, ",");
                             }
-                            pos += snprintf(json + pos, buffer_size - pos, "\"%s\"",
+                            strbuf_appendf(&json, "\"%s\"",
                                          projects[k].required_skills[l]);
                         }
                         
-                        pos += snprintf(json + pos, buffer_size - pos,
-                                     "],\"min_experience\":%d,\"deadline_days\":%d},\"score\":%d}",
+                        strbuf_appendf(&json, "],\"min_experience\":%d,\"deadline_days\":%d},\"score\":%d}",
                                      projects[k].min_experience,
                                      projects[k].deadline_days,
                                      assignments[j].score);
@@ -260,7 +335,7 @@ char* format_matches_json(const Freelancer* freelancers, int num_freelancers,
         }
         
         if (!assigned) {
-            pos += snprintf(json + pos, buffer_size - pos, "\"project\":null,\"score\":0}");
+            strbuf_appendf(&json, "\"project\":null,\"score\":0}");
         }
     }
 
@@ -275,35 +350,32 @@ char* format_matches_json(const Freelancer* freelancers, int num_freelancers,
         }
         
         if (!matched) {
-            pos += snprintf(json + pos, buffer_size - pos, ",");
-            pos += snprintf(json + pos, buffer_size - pos,
-                         "{\"freelancer\":null,\"project\":{\"id\":%d,\"name\":\"%s\",\"required_skills\":[",
+            strbuf_appendf(&json, ",");
+            strbuf_appendf(&json, "{\"freelancer\":null,\"project\":{\"id\":%d,\"name\":\"%s\",\"required_skills\":[",
                          projects[i].id, projects[i].name);
             
             // Add required skills
             for (int j = 0; j < projects[i].num_required_skills; j++) {
                 if (j > 0) {
-                    pos += snprintf(json + pos, buffer_size - pos, ",");
+                    strbuf_appendf(&json, ",");
                 }
-                pos += snprintf(json + pos, buffer_size - pos, "\"%s\"",
+                strbuf_appendf(&json, "\"%s\"",
                              projects[i].required_skills[j]);
             }
             
-            pos += snprintf(json + pos, buffer_size - pos,
-                         "],\"min_experience\":%d,\"deadline_days\":%d},\"score\":0}",
+            strbuf_appendf(&json, "],\"min_experience\":%d,\"deadline_days\":%d},\"score\":0}",
                          projects[i].min_experience,
                          projects[i].deadline_days);
         }
     }
     
     // Add statistics and close JSON object
-    pos += snprintf(json + pos, buffer_size - pos,
-                   "],\"statistics\":{\"assigned_count\":%d,\"assigned_percentage\":%.1f,"
+    strbuf_appendf(&json, "],\"statistics\":{\"assigned_count\":%d,\"assigned_percentage\":%.1f,"
                    "\"unassigned_count\":%d,\"unassigned_percentage\":%.1f}}",
                    assigned_count,
                    (float)assigned_count / num_freelancers * 100,
                    num_freelancers - assigned_count,
                    (float)(num_freelancers - assigned_count) / num_freelancers * 100);
     
-    return json;
+    return strbuf_detach(&json);
 }
@@ -5,21 +5,32 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #define MAX_FREELANCERS 100
 #define MAX_PROJECTS 100
 #define MAX_SKILLS 15
 #define MAX_SKILL_LENGTH 50
 #define MAX_NAME_LENGTH 100
+#define DAYS_PER_WEEK 7
+#define DEFAULT_DEADLINE_DAYS 14 // used when projects.csv has no deadline column
+
+// Weekly availability as a bitmask: bit d is set when the freelancer is free on day d
+typedef uint8_t AvailabilityMask;
+#define FULL_WEEK_MASK ((AvailabilityMask)((1u << DAYS_PER_WEEK) - 1))
+
+// Interned skill name (see skills.h)
+typedef uint16_t SkillId;
 
 // Structure to store freelancer information
 typedef struct {
     int id;
     char name[MAX_NAME_LENGTH];
     char skills[MAX_SKILLS][MAX_SKILL_LENGTH];
+    SkillId skill_ids[MAX_SKILLS];
     int num_skills;
     int experience;
-    bool availability[7]; // 7 days of the week
+    AvailabilityMask availability; // 7 days of the week
 } Freelancer;
 
 // Structure to store project information
@@ -27,6 +38,7 @@ typedef struct {
     int id;
     char name[MAX_NAME_LENGTH];
     char required_skills[MAX_SKILLS][MAX_SKILL_LENGTH];
+    SkillId required_skill_ids[MAX_SKILLS];
     int num_required_skills;
     int min_experience;
     int deadline_days;
@@ -39,22 +51,58 @@ typedef struct {
     int score;
 } Assignment;
 
-// Graph structures
-typedef struct GraphNode {
-    int id;
-    int weight;
-    struct GraphNode* next;
-} GraphNode;
+// Days of the week that fall before a deadline (day 0 is the start of the horizon)
+static inline AvailabilityMask deadline_mask(int deadline_days) {
+    if (deadline_days <= 0) return 0;
+    if (deadline_days >= DAYS_PER_WEEK) return FULL_WEEK_MASK;
+    return (AvailabilityMask)((1u << deadline_days) - 1);
+}
 
+// Graph structures
+// Freelancer-to-project edges in compressed sparse row form. Edges must be
+// added in non-decreasing freelancer order; the arrays are kept and reused
+// when the graph is reset for the next request.
 typedef struct {
-    GraphNode** adjacency_list;
-    int num_nodes;
-    int* node_types;  // 0 for freelancer, 1 for project
+    int num_freelancers;
+    int num_projects;
+    int num_edges;
+    int last_row;        // highest freelancer index with row_start filled in
+    int* row_start;      // first edge of each freelancer row
+    int* edge_project;   // project index (0-based) of each edge
+    int* edge_weight;    // compatibility score of each edge
+    int row_capacity;
+    int edge_capacity;
 } BipartiteGraph;
 
+// Edge range [begin, end) of a freelancer row
+static inline int graph_row_begin(const BipartiteGraph* graph, int freelancer) {
+    return freelancer <= graph->last_row ? graph->row_start[freelancer] : graph->num_edges;
+}
+
+static inline int graph_row_end(const BipartiteGraph* graph, int freelancer) {
+    return freelancer < graph->last_row ? graph->row_start[freelancer + 1] : graph->num_edges;
+}
+
+// Growable string used to build response bodies
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} StringBuffer;
+
+void strbuf_init(StringBuffer* buffer, size_t initial_capacity);
+void strbuf_appendf(StringBuffer* buffer, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+char* strbuf_detach(StringBuffer* buffer);
+
 // Function declarations for file reading and data processing
+int count_csv_rows(const char* filename);
 void read_freelancers(const char* filename, Freelancer* freelancers, int* num_freelancers);
+void read_freelancers_limit(const char* filename, Freelancer* freelancers,
+                            int max_freelancers, int* num_freelancers);
 void read_projects(const char* filename, Project* projects, int* num_projects);
+void read_projects_limit(const char* filename, Project* projects,
+                         int max_projects, int* num_projects);
 void read_availability(const char* filename, Freelancer* freelancers, int num_freelancers);
 int calculate_skill_mismatch(const Freelancer* freelancer, const Project* project);
 int calculate_experience_mismatch(const Freelancer* freelancer, const Project* project);
@@ -63,17 +111,26 @@ void generate_cost_matrix(Freelancer* freelancers, int num_freelancers,
                          Project* projects, int num_projects, 
                          int cost_matrix[MAX_FREELANCERS][MAX_PROJECTS]);
 
-// Graph operations
+// Graph operations (project_id is the project's node id, num_freelancers + index)
 BipartiteGraph* create_graph(int num_freelancers, int num_projects);
-void add_edge(BipartiteGraph* graph, int freelancer_id, int project_id, int weight);
+void reset_graph(BipartiteGraph* graph, int num_freelancers, int num_projects);
+// Returns 0, leaving the graph without the edge, if it could not grow
+int add_edge(BipartiteGraph* graph, int freelancer_id, int project_id, int weight);
 void free_graph(BipartiteGraph* graph);
 
 // Matching functions
-void match_freelancers_to_projects(const Freelancer* freelancers, int num_freelancers,
+// Fills assignments (num_freelancers slots); unused slots get freelancer_id -1.
+// Returns the number of assignments made.
+int match_freelancers_to_projects(const Freelancer* freelancers, int num_freelancers,
                                  const Project* projects, int num_projects,
                                  Assignment* assignments);
 int calculate_compatibility(const Freelancer* freelancer, const Project* project);
 
+// Pairs where the freelancer has less than `percent`% of the project's
+// min_experience score 0. The default, 0, never rules a pair out on experience.
+void set_min_experience_percent(int percent);
+int min_experience_percent(void);
+
 // Function to format matches as JSON
 char* format_matches_json(const Freelancer* freelancers, int num_freelancers,
                          const Project* projects, int num_projects,
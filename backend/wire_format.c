@@ -0,0 +1,128 @@
+#include "wire_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/uio.h>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "wire format writes host integers directly and assumes a little-endian target"
+#endif
+
+_Static_assert(sizeof(WireHeader) == 40, "WireHeader layout is part of the wire format");
+_Static_assert(sizeof(Assignment) == 3 * sizeof(int32_t), "records are written straight from Assignment");
+
+static size_t append_entry(char* out, int32_t id, const char* name) {
+    uint16_t length = (uint16_t)strlen(name);
+    memcpy(out, &id, sizeof(id));
+    memcpy(out + sizeof(id), &length, sizeof(length));
+    memcpy(out + sizeof(id) + sizeof(length), name, length);
+    return sizeof(id) + sizeof(length) + length;
+}
+
+// Name of the freelancer or project behind an assignment's id
+static const char* freelancer_name(const MatchResult* result, int id) {
+    int i = match_results_find_id(result->freelancer_ids, result->num_freelancers, id);
+    return i >= 0 ? result->freelancers[i].name : "";
+}
+
+static const char* project_name(const MatchResult* result, int id) {
+    int j = match_results_find_id(result->project_ids, result->num_projects, id);
+    return j >= 0 ? result->projects[j].name : "";
+}
+
+char* wire_build_string_table(const MatchResult* result, int offset, int count, size_t* length) {
+    const Assignment* records = result->assignments + offset;
+    size_t entry_overhead = sizeof(int32_t) + sizeof(uint16_t);
+    size_t total = 0;
+    for (int a = 0; a < count; a++) {
+        total += 2 * entry_overhead + strlen(freelancer_name(result, records[a].freelancer_id)) +
+                 strlen(project_name(result, records[a].project_id));
+    }
+
+    char* table = (char*)malloc(total + 1);
+    if (!table) {
+        *length = 0;
+        return NULL;
+    }
+    size_t pos = 0;
+    for (int a = 0; a < count; a++) {
+        pos += append_entry(table + pos, records[a].freelancer_id,
+                            freelancer_name(result, records[a].freelancer_id));
+    }
+    for (int a = 0; a < count; a++) {
+        pos += append_entry(table + pos, records[a].project_id,
+                            project_name(result, records[a].project_id));
+    }
+    *length = pos;
+    return table;
+}
+
+// writev until every vector has gone out, resuming after partial writes
+static int writev_all(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+    return 0;
+}
+
+int wire_send_matches(int client_socket, const MatchResult* result,
+                      int offset, int limit, int include_strings) {
+    int total = result->num_assignments;
+    if (offset < 0) offset = 0;
+    if (offset > total) offset = total;
+    if (limit < 0 || limit > total - offset) limit = total - offset;
+
+    size_t strings_length = 0;
+    char* strings = NULL;
+    if (include_strings) {
+        strings = wire_build_string_table(result, offset, limit, &strings_length);
+        if (!strings) return -1;
+    }
+    size_t records_length = (size_t)limit * sizeof(Assignment);
+
+    WireHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = WIRE_MAGIC;
+    header.version = WIRE_VERSION;
+    header.header_bytes = sizeof(WireHeader);
+    header.num_freelancers = strings ? limit : 0;
+    header.num_projects = strings ? limit : 0;
+    header.offset = offset;
+    header.num_records = limit;
+    header.total_records = total;
+    header.string_table_bytes = (uint32_t)strings_length;
+    header.dataset_version = result->version;
+
+    char http_headers[256];
+    int http_length = snprintf(http_headers, sizeof(http_headers),
+                               "HTTP/1.1 200 OK\r\n"
+                               "Content-Type: " WIRE_CONTENT_TYPE "\r\n"
+                               "Access-Control-Allow-Origin: *\r\n"
+                               "Content-Length: %zu\r\n"
+                               "Connection: close\r\n\r\n",
+                               sizeof(header) + records_length + strings_length);
+
+    struct iovec iov[4] = {
+        { http_headers, (size_t)http_length },
+        { &header, sizeof(header) },
+        { (void*)(result->assignments + offset), records_length },
+        { strings, strings_length },
+    };
+    int status = writev_all(client_socket, iov, 4);
+    free(strings);
+    return status;
+}
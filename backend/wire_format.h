@@ -0,0 +1,46 @@
+#ifndef WIRE_FORMAT_H
+#define WIRE_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "match_results.h"
+
+// Compact /matches encoding for batch consumers, selected with
+// "Accept: application/x-freelancer-matches". All integers are little-endian.
+//
+//   WireHeader                 40 bytes
+//   records                    num_records x { int32 freelancer_id, int32 project_id, int32 score }
+//   string table               string_table_bytes, absent when only ids were requested:
+//                                num_freelancers x { int32 id, uint16 length, name bytes }
+//                                num_projects    x { int32 id, uint16 length, name bytes }
+//
+// Records are the solver's Assignment array, so they are written without copying.
+// The string table names only the freelancers and projects of this page's
+// records, in record order, so it grows with the page rather than the dataset.
+#define WIRE_CONTENT_TYPE "application/x-freelancer-matches"
+#define WIRE_MAGIC 0x4D415046u  // "FPAM"
+#define WIRE_VERSION 2
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_bytes;
+    uint32_t num_freelancers;     // freelancer entries in the string table
+    uint32_t num_projects;        // project entries in the string table
+    uint32_t offset;              // index of the first record in the full assignment list
+    uint32_t num_records;
+    uint32_t total_records;
+    uint32_t string_table_bytes;
+    uint64_t dataset_version;
+} WireHeader;
+
+// Encode the names of the freelancers and projects in assignments
+// [offset, offset + count); caller frees
+char* wire_build_string_table(const MatchResult* result, int offset, int count, size_t* length);
+
+// Write a complete HTTP response carrying assignments [offset, offset + limit)
+// with a single writev. limit < 0 means all remaining. Returns 0 on success.
+int wire_send_matches(int client_socket, const MatchResult* result,
+                      int offset, int limit, int include_strings);
+
+#endif // WIRE_FORMAT_H
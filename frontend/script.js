@@ -2,9 +2,119 @@
 const matchingData = {
     freelancers: [],
     projects: [],
-    assignments: []
+    assignments: [],
+    summary: null
 };
 
+// Entries requested per /matches page
+const MATCHES_PAGE_SIZE = 500;
+
+// Fields the matches list and tables render
+const MATCHES_LIST_FIELDS = 'freelancer,project,score';
+
+// How far the loaded pages reach, and which solve they came from
+const matchesPaging = { offset: 0, total: null, version: null };
+
+// Delay between polls of a background solve
+const JOB_POLL_INTERVAL_MS = 500;
+
+// Start a solve of the current data (or join the one already running) and
+// wait for it, so a slow solve does not hold a request open until it times out
+async function waitForSolve() {
+    const response = await fetch('http://localhost:8080/jobs', { method: 'POST' });
+    if (!response.ok) {
+        throw new Error(`HTTP error! status: ${response.status}`);
+    }
+    let job = await response.json();
+    while (job.status === 'queued' || job.status === 'running') {
+        await new Promise(resolve => setTimeout(resolve, JOB_POLL_INTERVAL_MS));
+        const poll = await fetch(`http://localhost:8080/jobs/${job.job_id}`);
+        if (!poll.ok) {
+            throw new Error(`HTTP error! status: ${poll.status}`);
+        }
+        job = await poll.json();
+        console.log(`Solve ${job.phase}: ${(job.progress * 100).toFixed(1)}%`);
+    }
+    if (job.status !== 'done') {
+        throw new Error(`Solve ${job.status}`);
+    }
+}
+
+// Fetch one page of /matches entries, waiting out a solve in progress
+async function fetchMatchesPage(offset) {
+    const response = await fetch(`http://localhost:8080/matches?offset=${offset}&limit=${MATCHES_PAGE_SIZE}&fields=${MATCHES_LIST_FIELDS}`);
+    if (response.status === 202) {
+        await waitForSolve();
+        return fetchMatchesPage(offset);
+    }
+    if (!response.ok) {
+        throw new Error(`HTTP error! status: ${response.status}`);
+    }
+    const page = await response.json();
+    if (!page || !Array.isArray(page.matches)) {
+        throw new Error('Invalid data format received from server');
+    }
+    return page;
+}
+
+// Aggregates for the statistics panel and charts come precomputed
+async function fetchSummary() {
+    const response = await fetch('http://localhost:8080/matches/summary');
+    if (!response.ok) {
+        throw new Error(`HTTP error! status: ${response.status}`);
+    }
+    return response.json();
+}
+
+// Forget the loaded pages
+function resetMatches() {
+    matchingData.freelancers = [];
+    matchingData.projects = [];
+    matchingData.assignments = [];
+    matchesPaging.offset = 0;
+    matchesPaging.total = null;
+    matchesPaging.version = null;
+}
+
+// Load the next page of entries and render it. Pages from different solves
+// do not line up, so if the data was re-solved since the last page, start
+// again from the first one.
+async function loadMoreMatches() {
+    let page = await fetchMatchesPage(matchesPaging.offset);
+    if (matchesPaging.version !== null &&
+        (page.dataset_version !== matchesPaging.version || page.total_entries !== matchesPaging.total)) {
+        console.log('Matches were re-solved; reloading from the first page');
+        resetMatches();
+        page = await fetchMatchesPage(0);
+        matchingData.summary = await fetchSummary();
+        updateStatistics();
+        updateCharts();
+    }
+    matchesPaging.version = page.dataset_version;
+    matchesPaging.total = page.total_entries;
+    matchesPaging.offset += page.matches.length;
+
+    page.matches.forEach(match => {
+        if (!match) return;
+        if (match.freelancer) matchingData.freelancers.push(match.freelancer);
+        if (match.project) matchingData.projects.push(match.project);
+        if (match.freelancer && match.freelancer.id && match.project && match.project.id) {
+            matchingData.assignments.push(match);
+        }
+    });
+    console.log(`Loaded ${matchesPaging.offset} of ${matchesPaging.total} entries`);
+
+    populateMatchesAndUnmatchedTables();
+    populateMatchesList();
+
+    const loadMoreButton = document.getElementById('loadMoreMatches');
+    if (loadMoreButton) {
+        const remaining = matchesPaging.offset < matchesPaging.total && page.matches.length > 0;
+        loadMoreButton.style.display = remaining ? '' : 'none';
+        loadMoreButton.textContent = `Load more (${matchesPaging.offset} of ${matchesPaging.total})`;
+    }
+}
+
 // Chart instances
 let skillsChart, experienceChart, matchQualityChart;
 
@@ -14,56 +124,16 @@ async function loadData(retryCount = 0, maxRetries = 3) {
         console.log('Starting data load...');
         
         // Clear existing data
-        matchingData.freelancers = [];
-        matchingData.projects = [];
-        matchingData.assignments = [];
+        resetMatches();
+        matchingData.summary = null;
         
         console.log(`Fetching data from API (attempt ${retryCount + 1} of ${maxRetries})...`);
-        const response = await fetch('http://localhost:8080/matches');
-
-        if (!response.ok) {
-            throw new Error(`HTTP error! status: ${response.status}`);
-        }
-
-        const data = await response.json();
-        console.log('Raw data received:', data);
-
-        if (!data || !Array.isArray(data.matches)) {
-            throw new Error('Invalid data format received from server');
-        }
-
-        // Process matches
-        const validMatches = data.matches.filter(match => 
-            match && 
-            match.freelancer && 
-            match.freelancer.id && 
-            match.project && 
-            match.project.id
-        );
-
-        console.log(`Found ${validMatches.length} valid matches out of ${data.matches.length} total`);
-
-        // Store all freelancers and projects, including unmatched ones
-        const freelancerMap = new Map();
-        const projectMap = new Map();
-
-        // First, add all freelancers and projects from matches
-        data.matches.forEach(match => {
-            if (match.freelancer) {
-                freelancerMap.set(match.freelancer.id, match.freelancer);
-            }
-            if (match.project) {
-                projectMap.set(match.project.id, match.project);
-            }
-        });
+        await waitForSolve();
 
-        // Store all entities and valid matches
-        matchingData.freelancers = Array.from(freelancerMap.values());
-        matchingData.projects = Array.from(projectMap.values());
-        matchingData.assignments = validMatches;
+        matchingData.summary = await fetchSummary();
 
-        // Populate tables for visualization
-        populateMatchesAndUnmatchedTables();
+        // Only the first page; further pages load on demand
+        await loadMoreMatches();
 
         console.log('Processed data:', {
             freelancers: matchingData.freelancers.length,
@@ -77,8 +147,6 @@ async function loadData(retryCount = 0, maxRetries = 3) {
             
             console.log('Updating statistics...');
             updateStatistics();
-            console.log('Populating matches list...');
-            populateMatchesList();
             console.log('Initializing charts...');
             initializeCharts();
             console.log('Updating charts...');
@@ -223,19 +291,18 @@ function getScoreColor(score) {
 
 // Update statistics display
 function updateStatistics() {
-    const actualMatches = matchingData.assignments.filter(a => 
-        a.freelancer && 
-        a.project && 
-        a.score >= 60  // Only count matches with score >= 60%
-    );
+    const summary = matchingData.summary;
+    const totalFreelancers = summary.total_freelancers;
+    const totalProjects = summary.total_projects;
+    const strongMatches = summary.statistics.strong_matches;  // matches with score >= 60%
 
-    document.getElementById('totalFreelancers').textContent = matchingData.freelancers.length;
-    document.getElementById('totalProjects').textContent = matchingData.projects.length;
-    document.getElementById('matchedPairs').textContent = actualMatches.length;
+    document.getElementById('totalFreelancers').textContent = totalFreelancers;
+    document.getElementById('totalProjects').textContent = totalProjects;
+    document.getElementById('matchedPairs').textContent = strongMatches;
     
     // Success rate is based on how many projects were successfully matched
-    const successRate = matchingData.projects.length > 0
-        ? (actualMatches.length / Math.min(matchingData.projects.length, matchingData.freelancers.length) * 100).toFixed(1)
+    const successRate = totalProjects > 0
+        ? (strongMatches / Math.min(totalProjects, totalFreelancers) * 100).toFixed(1)
         : 0;
     document.getElementById('successRate').textContent = `${successRate}%`;
 }
@@ -323,11 +390,31 @@ function showDetails(assignment) {
                     <div class="score-fill" style="width: ${assignment.score}%; background-color: ${getScoreColor(assignment.score)}"></div>
                 </div>
             </div>
+            <div class="modal-section">
+                <h3>Why This Match</h3>
+                <div id="explainResult">Loading...</div>
+                <p>
+                    <input type="number" id="explainProjectInput" placeholder="Another project ID">
+                    <button id="explainProjectBtn">Why not this project?</button>
+                </p>
+                <div id="explainOtherResult"></div>
+            </div>
         </div>
     `;
     
     modal.style.display = 'block';
     
+    // Answered from the solver's stored duals, so it is cheap on every click
+    showExplanation(assignment.freelancer.id, assignment.project.id,
+                    modalContent.querySelector('#explainResult'));
+    modalContent.querySelector('#explainProjectBtn').onclick = () => {
+        const projectId = modalContent.querySelector('#explainProjectInput').value.trim();
+        if (projectId) {
+            showExplanation(assignment.freelancer.id, projectId,
+                            modalContent.querySelector('#explainOtherResult'));
+        }
+    };
+    
     // Close button handler
     modal.querySelector('.close-button').onclick = () => {
         modal.style.display = 'none';
@@ -341,6 +428,51 @@ function showDetails(assignment) {
     };
 }
 
+// Fill `container` with the backend's explanation of a freelancer/project pair
+async function showExplanation(freelancerId, projectId, container) {
+    container.textContent = 'Loading...';
+    try {
+        const response = await fetch(`http://localhost:8080/explain?freelancer=${encodeURIComponent(freelancerId)}&project=${encodeURIComponent(projectId)}`);
+        if (response.status === 202) {
+            // The body is the running job's status, not an explanation
+            container.textContent = 'Solve in progress...';
+            await waitForSolve();
+            return showExplanation(freelancerId, projectId, container);
+        }
+        const explanation = await response.json();
+        if (!response.ok) {
+            container.textContent = explanation.error || 'No explanation available.';
+            return;
+        }
+        
+        const lines = [`<p><strong>Pair score:</strong> ${explanation.score}%</p>`];
+        if (explanation.assigned) {
+            lines.push('<p>This is the freelancer\'s assigned project.</p>');
+        } else {
+            const own = explanation.freelancer_assignment;
+            const taken = explanation.project_assignment;
+            lines.push(`<p><strong>Freelancer got:</strong> ${own ? `project ${own.project_id} (score ${own.score}%)` : 'no project'}</p>`);
+            lines.push(`<p><strong>Project went to:</strong> ${taken ? `freelancer ${taken.freelancer_id} (score ${taken.score}%)` : 'nobody'}</p>`);
+        }
+        if (explanation.reduced_cost == null) {
+            lines.push('<p>This solve was split across workers, so no sensitivity is available.</p>');
+        } else {
+            lines.push(`<p><strong>Reduced cost:</strong> ${explanation.reduced_cost}</p>`);
+            if (!explanation.assigned && explanation.min_score_increase != null) {
+                lines.push(explanation.score + explanation.min_score_increase <= 100 ?
+                    `<p>A rise of less than ${explanation.min_score_increase} points in this score cannot change the assignment.</p>` :
+                    '<p>Even a perfect score would not change the assignment.</p>');
+            }
+        }
+        if (explanation.fairness_penalty > 0) {
+            lines.push(`<p><strong>Fairness penalty:</strong> ${explanation.fairness_penalty} points</p>`);
+        }
+        container.innerHTML = lines.join('');
+    } catch (error) {
+        container.textContent = 'Error loading explanation.';
+    }
+}
+
 // Initialize charts
 function initializeCharts() {
     // Skills distribution chart
@@ -413,54 +545,30 @@ function updateCharts() {
 
 // Update skills distribution chart
 function updateSkillsChart() {
-    const skillCounts = {};
+    const skillCounts = matchingData.summary.skill_counts;
     
-    matchingData.freelancers.forEach(freelancer => {
-        freelancer.skills.forEach(skill => {
-            skillCounts[skill] = (skillCounts[skill] || 0) + 1;
-        });
-    });
-    
-    skillsChart.data.labels = Object.keys(skillCounts);
-    skillsChart.data.datasets[0].data = Object.values(skillCounts);
+    skillsChart.data.labels = skillCounts.map(entry => entry.skill);
+    skillsChart.data.datasets[0].data = skillCounts.map(entry => entry.count);
     skillsChart.update();
 }
 
 // Update experience distribution chart
 function updateExperienceChart() {
-    const expCounts = {};
-    
-    matchingData.freelancers.forEach(freelancer => {
-        const exp = freelancer.experience;
-        expCounts[exp] = (expCounts[exp] || 0) + 1;
-    });
+    const expCounts = matchingData.summary.experience_counts;
     
-    experienceChart.data.labels = Object.keys(expCounts).map(exp => `${exp} years`);
-    experienceChart.data.datasets[0].data = Object.values(expCounts);
+    experienceChart.data.labels = expCounts.map(entry => `${entry.experience} years`);
+    experienceChart.data.datasets[0].data = expCounts.map(entry => entry.count);
     experienceChart.update();
 }
 
 // Update match quality chart
 function updateMatchQualityChart() {
-    const qualityCounts = [0, 0, 0, 0];
-    
-    // Count all assignments including null matches
-    matchingData.assignments.forEach(assignment => {
-        if (!assignment.freelancer || !assignment.project) {
-            qualityCounts[3]++; // Count unmatched as poor quality
-        } else if (assignment.score >= 80) {
-            qualityCounts[0]++;
-        } else if (assignment.score >= 60) {
-            qualityCounts[1]++;
-        } else if (assignment.score >= 40) {
-            qualityCounts[2]++;
-        } else {
-            qualityCounts[3]++;
-        }
-    });
+    const summary = matchingData.summary;
+    const quality = summary.quality;
+    const qualityCounts = [quality.excellent, quality.good, quality.fair, quality.poor];
     
     // Also count unmatched freelancers and projects
-    const unmatched = Math.abs(matchingData.freelancers.length - matchingData.projects.length);
+    const unmatched = Math.abs(summary.total_freelancers - summary.total_projects);
     qualityCounts[3] += unmatched;
     
     matchQualityChart.data.datasets[0].data = qualityCounts;
@@ -706,6 +814,13 @@ document.addEventListener('DOMContentLoaded', () => {
     // Visualization controls
     document.getElementById('startVisualization').addEventListener('click', startVisualization);
     document.getElementById('resetVisualization').addEventListener('click', resetVisualization);
+    document.getElementById('loadMoreMatches').addEventListener('click', async () => {
+        try {
+            await loadMoreMatches();
+        } catch (error) {
+            console.error('Error loading more matches:', error);
+        }
+    });
     
     // Search functionality
     document.getElementById('searchInput').addEventListener('input', (e) => {
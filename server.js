@@ -45,34 +45,40 @@ app.get('/data/:file', async (req, res) => {
     }
 });
 
-// Proxy requests to the C backend
-app.get('/matches', (req, res) => {
+// Proxy requests to the C backend, streaming the body through unchanged
+// (including any Content-Encoding the backend negotiated)
+app.get(['/matches', '/matches/summary'], (req, res) => {
+    const headers = { 'Accept': req.get('Accept') || 'application/json' };
+    if (req.get('Accept-Encoding')) {
+        headers['Accept-Encoding'] = req.get('Accept-Encoding');
+    }
+
     const options = {
         hostname: 'localhost',
         port: 8080,
-        path: '/matches',
+        path: req.originalUrl,
         method: 'GET',
-        headers: {
-            'Accept': 'application/json',
-            'Content-Type': 'application/json'
-        }
+        headers
     };
 
     const proxyReq = http.request(options, (proxyRes) => {
-        let data = '';
-        proxyRes.on('data', (chunk) => {
-            data += chunk;
-        });
-        proxyRes.on('end', () => {
-            res.setHeader('Content-Type', 'application/json');
-            res.setHeader('Access-Control-Allow-Origin', '*');
-            res.send(data);
+        res.status(proxyRes.statusCode);
+        ['content-type', 'content-encoding', 'content-length', 'vary'].forEach((name) => {
+            if (proxyRes.headers[name]) {
+                res.setHeader(name, proxyRes.headers[name]);
+            }
         });
+        res.setHeader('Access-Control-Allow-Origin', '*');
+        proxyRes.pipe(res);
     });
 
     proxyReq.on('error', (error) => {
         console.error('Error proxying request:', error);
-        res.status(500).json({ error: 'Internal server error' });
+        if (!res.headersSent) {
+            res.status(500).json({ error: 'Internal server error' });
+        } else {
+            res.end();
+        }
     });
 
     proxyReq.end();